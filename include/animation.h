@@ -102,6 +102,48 @@ typedef struct AnimationArray {
     Animation* animationArr;
 } AnimationArray;
 
+/**
+ * Immutable data of a sprite animation, shared by every entity that plays it.
+ *
+ * @param fps           Frames per second (speed) of this animation
+ * @param numOfFrames   Number of frames that capture each tile in texture.
+ * @param frames        List of frames the capture each tile's x, y, width and height in texture.
+ * @param texture       Tile texture for this animation.
+ *
+ * ? @note The frames are computed once at load, so starting an entity that plays the
+ *         animation does not allocate anything.
+ * ? @note Each descriptor must be unloaded with UnloadAnimationDescriptor.
+ */
+typedef struct AnimationDescriptor {
+    /** The frames per second of this animation. */
+    int fps;
+    /** The number of frames that capture each tile in texture. */
+    int numOfFrames;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * The list of frames the capture each tile's x, y, width and height in texture.
+     */
+    Rectangle* frames;
+    /** The tile texture for this animation. */
+    Texture2D texture;
+} AnimationDescriptor;
+
+/**
+ * Playback state of an AnimationDescriptor for a single entity.
+ *
+ * @param curFrame  Current frame being rendered on the screen.
+ * @param timer     Time for this animation.
+ *
+ * ? @note Timer must be started with StartTimer from timer.c see Timer.
+ */
+typedef struct AnimationState {
+    /** Current frame being rendered on the screen. */
+    int curFrame;
+    /** The time for this animation. */
+    Timer timer;
+} AnimationState;
+
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
@@ -121,6 +163,21 @@ typedef struct AnimationArray {
  */
 Animation CreateAnimation(int fps, int tileWidth, int tileHeight, TextureFile textureType);
 
+/**
+ * Constructs an AnimationDescriptor, computing the frames of the given texture.
+ *
+ * ! @attention returns an empty AnimationDescriptor if given an invalid textureType.
+ *
+ * @param fps               Rate at which the sprite frames are updated.
+ * @param tileWidth         Width of a single tile.
+ * @param tileHeight        Height of a single tile.
+ * @param textureFileType   Type of texture as a TextureFile.
+ * @returns An AnimationDescriptor.
+ *
+ * ! @note This function is responsible for creating descriptor.frames in the heap.
+ */
+AnimationDescriptor CreateAnimationDescriptor(int fps, int tileWidth, int tileHeight, TextureFile textureType);
+
 /**
  * Draws the provided animation at the destination rectangle.
  *
@@ -138,6 +195,24 @@ Animation CreateAnimation(int fps, int tileWidth, int tileHeight, TextureFile te
  */
 void DrawAnimation(Animation* animation, Rectangle dest, int entityWidth, int entityHeight, float rotation);
 
+/**
+ * Draws a shared animation with the playback state of an entity at the destination rectangle.
+ *
+ * ! @attention returns if given a NULL descriptor or state.
+ *
+ * @param descriptor    Shared data of the animation to draw.
+ * @param state         Playback state of the entity, its curFrame is updated.
+ * @param dest          Destination rectangle to draw on.
+ * @param entityWidth   Width of an entity's sprite tile.
+ * @param entityHeight  Height of an entity's sprite tile.
+ * @param rotation      Rotation of the Rectangles to draw.
+ *
+ * ? @note Same as DrawAnimation, but the animation data is not copied per entity.
+ */
+void DrawAnimationState(
+    const AnimationDescriptor* descriptor, AnimationState* state, Rectangle dest,
+    int entityWidth, int entityHeight, float rotation);
+
 /**
  * Draws the provided animation at a given frame at the destination rectangle.
  *
@@ -176,4 +251,13 @@ void UnloadAnimationArray(AnimationArray* animationArray);
  */
 void AnimationUnload(Animation* animation);
 
+/**
+ * Frees the frames of an AnimationDescriptor and sets its number of frames to zero.
+ *
+ * ! @attention returns if given a NULL descriptor.
+ *
+ * @param descriptor The descriptor to unallocate.
+ */
+void UnloadAnimationDescriptor(AnimationDescriptor* descriptor);
+
 #endif // ANIMATION_H_
\ No newline at end of file
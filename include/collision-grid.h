@@ -0,0 +1,240 @@
+/**********************************************************************************************
+ *
+ **   collision-grid.h is responsible for defining a dense grid with the solidity of every tile
+ **   in the world tilemap, so collision queries can be answered in constant time.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include raylib.h, raymath.h, texture.h
+ *    @cite raylib
+ *
+ **********************************************************************************************/
+
+#ifndef COLLISION_GRID_H
+#define COLLISION_GRID_H
+
+#include "raylib.h"
+#include "raymath.h"
+#include "texture.h"
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Max number of collision rectangles listed by the broad phase of a single movement sweep. */
+#define MAX_SWEPT_RECS 64
+
+/**
+ * Max error (pixels) of SampleWallDistance compared to the real distance to the closest solid tile.
+ * Half a tile diagonal from measuring between tile centers plus a tile diagonal from the bilinear
+ * interpolation between them.
+ */
+#define WALL_DISTANCE_ERROR (1.5f * 1.41421356f * TILE_WIDTH)
+
+/** Cost of stepping to an orthogonal and to a diagonal neighbour tile in the path searches. */
+#define STRAIGHT_STEP_COST 10
+#define DIAGONAL_STEP_COST 14
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Dense byte-per-tile grid representing which tiles of the map are solid (collidable).
+ *
+ * @param width         Width of the grid in tiles
+ * @param height        Height of the grid in tiles
+ * @param cells         Array of width * height cells (row-major). Non-zero means solid.
+ * @param recIndices    Array of width * height cells with the index of the merged collision
+ *                      rectangle that covers each tile, or -1 for non-solid tiles.
+ * @param recs          Array with the merged collision rectangles (world coordinates)
+ * @param numOfRecs     Number of merged collision rectangles
+ * @param wallDistances Array of width * height cells with the distance (pixels) from the center
+ *                      of each tile to the center of the closest solid tile.
+ * @param revision      Counter increased every time the solidity of the grid changes, so the
+ *                      data computed from it knows when it is stale.
+ *
+ * ? @note Cells are accessed through the formula: cells[y * width + x].
+ * ? @note recIndices and recs are only available after MergeSolidTiles is called.
+ * ? @note wallDistances is only available after ComputeWallDistances is called.
+ */
+typedef struct CollisionGrid {
+    /** Width of the grid in tiles. */
+    int width;
+    /** Height of the grid in tiles. */
+    int height;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major array with the solidity of each tile. Non-zero means the tile is solid.
+     */
+    unsigned char* cells;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major array with the index of the merged rectangle covering each tile (-1 if none).
+     */
+    int* recIndices;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Array of solid tiles merged into maximal rectangles in world coordinates (pixels).
+     */
+    Rectangle* recs;
+    /** Number of merged collision rectangles. */
+    int numOfRecs;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major array with the distance (pixels) from each tile to the closest solid tile (0 if solid).
+     */
+    float* wallDistances;
+    /** Counter increased every time the solidity of the grid changes. */
+    unsigned int revision;
+} CollisionGrid;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Grid with the solidity of all the tiles of the world tilemap. */
+extern CollisionGrid collisionGrid;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates the collisionGrid with the given dimensions and with all tiles non-solid.
+ *
+ * ! @note Allocates memory for the cells of the grid. Must be freed with UnloadCollisionGrid.
+ *
+ * @param width     Width of the grid in tiles
+ * @param height    Height of the grid in tiles
+ */
+void CreateCollisionGrid(int width, int height);
+
+/**
+ * Marks the tile at the (x, y) coordinate as solid.
+ *
+ * ! @attention Returns if the coordinate is outside of the grid.
+ *
+ * @param x Horizontal (x) tile coordinate
+ * @param y Vertical (y) tile coordinate
+ */
+void SetSolidTile(int x, int y);
+
+/**
+ * Checks if the tile at the (x, y) coordinate is solid.
+ *
+ * @param x Horizontal (x) tile coordinate
+ * @param y Vertical (y) tile coordinate
+ * @return  True if the tile is solid, false otherwise.
+ *
+ * ? @note Tiles outside of the grid are considered solid.
+ */
+bool IsSolid(int x, int y);
+
+/**
+ * Checks if an entity can step from a tile to its neighbour at the given offset.
+ *
+ * @param x         Horizontal (x) tile coordinate
+ * @param y         Vertical (y) tile coordinate
+ * @param offsetX   Horizontal offset of the neighbour (-1, 0 or 1)
+ * @param offsetY   Vertical offset of the neighbour (-1, 0 or 1)
+ * @return          True if the neighbour is not solid and, for diagonal steps, neither are the
+ *                  two tiles beside the step (no corner cutting).
+ */
+bool IsStepWalkable(int x, int y, int offsetX, int offsetY);
+
+/**
+ * Checks if a Rectangle in world coordinates (pixels) overlaps any solid tile.
+ *
+ * @param rec   Rectangle in world coordinates
+ * @return      True if any tile under the rectangle is solid, false otherwise.
+ */
+bool IsRecSolid(Rectangle rec);
+
+/**
+ * Merges adjacent solid tiles into maximal rectangles (greedy meshing) so collisions are
+ * checked against a few large rectangles instead of every single tile.
+ *
+ * ! @attention Must be called after all the solid tiles are set.
+ * ! @note Allocates memory for the recIndices and recs arrays of the collisionGrid.
+ *
+ * ? @note Also removes the seams between neighbouring tiles that entities could snag on.
+ */
+void MergeSolidTiles();
+
+/**
+ * Computes the exact euclidean distance transform of the solid tiles (Felzenszwalb and
+ * Huttenlocher), storing for each tile how far it is from the closest solid tile.
+ *
+ * ! @attention Must be called after all the solid tiles are set.
+ * ! @note Allocates memory for the wallDistances array of the collisionGrid.
+ *
+ * ? @note Runs in linear time on the number of tiles (one pass per row and one per column).
+ * ? @note Tiles outside of the map are not considered walls, same as the merged collision rectangles.
+ */
+void ComputeWallDistances();
+
+/**
+ * Samples the distance from a point to the closest solid tile, interpolating bilinearly between
+ * the distances of the four closest tile centers.
+ *
+ * @param pos   Point in world coordinates
+ * @return      Approximate distance in pixels to the closest solid tile.
+ *
+ * ! @attention The result can be off by up to WALL_DISTANCE_ERROR pixels. Subtract it when a
+ *              conservative distance is needed.
+ */
+float SampleWallDistance(Vector2 pos);
+
+/**
+ * Broad phase for swept collisions. Lists the merged collision rectangles overlapped by a
+ * hitbox sweeping from its current position through the given displacement.
+ *
+ * @param hitbox        Hitbox at the start of the movement (world coordinates)
+ * @param displacement  Movement of the hitbox during this step (already scaled by delta time)
+ * @param recs          Array that will receive the collision rectangles (world coordinates)
+ * @param maxRecs       Size of the recs array
+ * @return              Number of rectangles written to the array.
+ *
+ * ! @attention Needs MergeSolidTiles to be called first.
+ *
+ * ? @note The cost depends only on how far the hitbox moves, not on the size of the map.
+ * ? @note Rectangles touching the sweep are listed as well, the narrow phase decides if they collide.
+ */
+int GetSweptCollisionRecs(Rectangle hitbox, Vector2 displacement, Rectangle recs[], int maxRecs);
+
+/**
+ * Checks if the segment between two points crosses any solid tile, visiting each tile crossed
+ * by the segment exactly once (Amanatides and Woo grid traversal).
+ *
+ * @param from  Start point of the segment (world coordinates)
+ * @param to    End point of the segment (world coordinates)
+ * @return      True if no solid tile is crossed, false otherwise.
+ *
+ * ? @note Stops at the first solid tile found.
+ * ? @note Tiles outside of the grid are considered solid.
+ */
+bool IsLineOfSightClear(Vector2 from, Vector2 to);
+
+/**
+ * Checks the line of sight from one point to many targets in a single call.
+ *
+ * @param origin    Start point of all the segments (world coordinates)
+ * @param targets   End points of the segments (world coordinates)
+ * @param isClear   Array that receives, for each target, if its line of sight is clear
+ * @param size      Number of targets
+ * @return          Number of targets with a clear line of sight.
+ *
+ * ? @note Calls IsLineOfSightClear for each target, or none if the origin tile is solid.
+ * ? @note The enemies check the player through the shared playerView (field-of-view.h) instead,
+ *         this is for origins other than the tile of the player.
+ */
+int GetLinesOfSight(Vector2 origin, const Vector2 targets[], bool isClear[], int size);
+
+/**
+ * Frees the memory used by the collisionGrid and resets its dimensions to zero.
+ */
+void UnloadCollisionGrid();
+
+#endif // COLLISION_GRID_H
@@ -17,6 +17,15 @@
 #include "raylib.h"
 #include "raymath.h"
 
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Max number of contacts that can be resolved in a single movement. */
+#define MAX_COLLISION_CONTACTS 64
+
+/** Max number of rectangles in a RectangleBatch. Must be a multiple of the SIMD width (4). */
+#define RECTANGLE_BATCH_CAPACITY 64
+
 //* ------------------------------------------
 //* STRUCTURES
 
@@ -69,37 +78,41 @@ typedef struct RayCollision2D {
  * Structure that contains information about a specific collided hitbox so it
  * can be sorted for better collision resolving.
  *
- * @param index     Represents the index of a collided hitbox in the tilemap array or a list.
- * @param timeHit   Time of the collision
+ * @param hitbox    Hitbox that was collided with
+ * @param collision Information about the collision from the detection pass
  *
- * @note Check RayCollision2D for more in-depth information about timeHit.
+ * @note Check RayCollision2D for more in-depth information about the collision.
  */
-typedef struct CollidedHitboxInfo {
-    /** Index of the collided hitbox in the array of hitboxes. */
-    Vector2 index;
-    /** Contact time of the collision. Used to sort the closest collision.*/
-    float timeHit;
-} CollidedHitboxInfo;
+typedef struct CollisionContact {
+    /** Hitbox (Rectangle) that was collided with. */
+    Rectangle hitbox;
+    /** Collision detected with the hitbox. Its timeHit is used to sort the closest collision. */
+    RayCollision2D collision;
+} CollisionContact;
 
 /**
- * Collision node struct to keep track of the detected collisions in a collision linked list.
+ * Structure-of-arrays block of rectangles used to test one ray against many rectangles at once.
+ *
+ * @param x         Array with the x coordinate of each rectangle
+ * @param y         Array with the y coordinate of each rectangle
+ * @param width     Array with the width of each rectangle
+ * @param height    Array with the height of each rectangle
+ * @param size      Number of rectangles in the batch
  *
- * @param collidedHitbox    Information about a specific detected collided hitbox
- * @param next              Pointer to the next node on the linked list
+ * ? @note Should be initialized with size zero and filled through AddRectangleToBatch.
  */
-typedef struct CollisionNode CollisionNode;
-struct CollisionNode {
-    /** Information about the collided hitbox. */
-    CollidedHitboxInfo collidedHitbox;
-    /** Pointer to the next node on the list. */
-    CollisionNode* next;
-};
-
-//* ------------------------------------------
-//* GLOBAL VARIABLES
-
-/** Linked list with indexes to all the possible collidable tiles. */
-extern CollisionNode* collidableTiles;
+typedef struct RectangleBatch {
+    /** X coordinate of each rectangle. */
+    float x[RECTANGLE_BATCH_CAPACITY];
+    /** Y coordinate of each rectangle. */
+    float y[RECTANGLE_BATCH_CAPACITY];
+    /** Width of each rectangle. */
+    float width[RECTANGLE_BATCH_CAPACITY];
+    /** Height of each rectangle. */
+    float height[RECTANGLE_BATCH_CAPACITY];
+    /** Number of rectangles in the batch. */
+    int size;
+} RectangleBatch;
 
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
@@ -127,43 +140,61 @@ RayCollision2D RayRectCollision(Ray2D ray, Rectangle hitbox);
  * @param hitboxIn      Input Rectangle that will check collision
  * @param direction     Vector that corresponds to the input rectangle velocity/direction vector
  * @param hitboxTarget  Target Rectangle that the collision will be checked with
+ * @param deltaTime     Duration of the movement in seconds (simulation step)
  * @return              Information about the collision.
  *
  * ? @note Resolving the collision is still necessary. This function is only for detection.
  */
-RayCollision2D HitboxCollision(Rectangle hitboxIn, Vector2 direction, Rectangle hitboxTarget);
+RayCollision2D HitboxCollision(
+    Rectangle hitboxIn, Vector2 direction, Rectangle hitboxTarget, float deltaTime);
 
 /**
- * Creates a linked lists for detected collisions and returns a pointer to the first node.
+ * Function used to check the collision between a Ray2D and all the rectangles of a RectangleBatch.
+ * Uses SSE to test 4 rectangles at a time when available and a scalar fallback otherwise.
+ *
+ * @param ray           Ray2D used to test the collisions
+ * @param batch         Batch of rectangles that the ray will collide with
+ * @param hitIndex      Receives the index of the earliest collided rectangle or -1. (Can be NULL)
+ * @param collisions    Receives the collision with each rectangle of the batch, the same as
+ *                      RayRectCollision would return. (Can be NULL)
+ * @return              The earliest collision that happens between the ray's origin and
+ *                      direction point (timeHit between 0 and 1).
  *
- * @param index     Integer that represents the index of the collided hitbox in a specific array/list.
- * @param timeHit   Time of the collision (Check struct RayCollision2D)
- * @return          Pointer to the head node of the CollisionList
+ * ? @note Resolving the collision is still necessary. This function is only for detection.
  */
-CollisionNode* CreateCollisionList(int indexX, int indexY, float timeHit);
+RayCollision2D RayRectBatchCollision(
+    Ray2D ray, const RectangleBatch* batch, int* hitIndex, RayCollision2D collisions[]);
 
 /**
- * Adds a RayCollision2D to the end of the CollisionNode linked list.
+ * Adds a Rectangle to the end of a RectangleBatch.
+ *
+ * ! @attention Returns false if the batch is full.
  *
- * @param head      Pointer to the head node of a CollisionNode list
- * @param index     Integer that represents the index of the collided hitbox in a specific array/list.
- * @param timeHit   Time of the collision (Check struct RayCollision2D)
+ * @param batch Pointer to the batch
+ * @param rec   Rectangle to add
+ * @return      True if the rectangle was added, false otherwise.
  */
-void AddCollisionNode(CollisionNode* head, int indexX, int indexY, float timeHit);
+bool AddRectangleToBatch(RectangleBatch* batch, Rectangle rec);
 
 /**
- * Sorts a CollisionNode linked list based on the timeHit of the
- * collisions detected in the list. (Smaller to bigger)
+ * Returns the target hitbox expanded by the size of the input hitbox (Minkowski sum), which is
+ * the Rectangle that the ray from the center of hitboxIn collides with in HitboxCollision.
  *
- * @param head      Pointer to the head node of a CollisionNode list
+ * @param hitboxIn      Moving Rectangle
+ * @param hitboxTarget  Target Rectangle
+ * @return              Expanded target Rectangle.
  */
-void SortCollisionList(CollisionNode* head);
+Rectangle ExpandHitbox(Rectangle hitboxIn, Rectangle hitboxTarget);
 
 /**
- * Frees the memory of all the nodes in the CollisionNode linked list.
+ * Sorts an array of CollisionContact based on the timeHit of the
+ * collisions detected. (Smaller to bigger)
+ *
+ * @param contacts  Array of contacts
+ * @param size      Number of contacts in the array
  *
- * @param head      Pointer to the head node of a CollisionNode list
+ * ? @note Uses insertion sort, as the number of contacts of a movement is always small.
  */
-void FreeCollisionList(CollisionNode* head);
+void SortCollisionContacts(CollisionContact contacts[], int size);
 
 #endif //! COLLISION_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+/***********************************************************************************************
+ *
+ **   Provides definitions for a spatial hash of the enemies keyed by the tile cell they are in,
+ **   so attacks and aggro checks only visit the enemies close to a point or an area.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include enemy-list.h
+ *
+ ***********************************************************************************************/
+
+#ifndef ENEMY_HASH_H_
+#define ENEMY_HASH_H_
+
+#include "enemy-list.h"
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Number of buckets of the enemy spatial hash (must be a power of two). */
+#define ENEMY_HASH_BUCKETS 4096
+
+/** Initial number of slots an EnemyQuery has room for, it grows to fit the enemies found. */
+#define ENEMY_QUERY_INITIAL_CAPACITY 64
+
+/** Max number of neighbours an enemy checks collision with, found by QueryEnemiesInRect. */
+#define MAX_ENEMY_NEIGHBOURS 16
+
+/** Biggest enemy size, used to find the cells of enemies that reach into a queried area. */
+#define ENEMY_MAX_WIDTH  ENEMY_WAFFLES_WIDTH
+#define ENEMY_MAX_HEIGHT ENEMY_WAFFLES_HEIGHT
+
+/**
+ * Radius (tiles) of the field of view of the player. Covers AGRO_RANGE between positions plus
+ * the offset of the biggest enemy center.
+ */
+#define PLAYER_VIEW_RADIUS ((AGRO_RANGE + ENEMY_MAX_HEIGHT) / TILE_WIDTH + 1)
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Growable list of the slots of the enemies found by a query of the spatial hash.
+ *
+ * @param slots     Slots of the enemies found.
+ * @param size      Number of enemies found by the last query.
+ * @param capacity  Number of slots allocated.
+ *
+ * ? @note Should be zero initialized, the slots are allocated by the first query.
+ */
+typedef struct EnemyQuery {
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    int* slots;
+    int size;
+    int capacity;
+} EnemyQuery;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Inserts the enemy in a slot of the pool in the bucket of the tile cell of its position.
+ *
+ * @param slot  The slot of the enemy to insert.
+ *
+ * ? @note Does not allocate memory, the buckets are chained through the pool (nextInCell).
+ */
+void InsertEnemyInHash(int slot);
+
+/**
+ * Removes the enemy in a slot of the pool from the bucket of its tile cell.
+ *
+ * ! @attention Must be called before the enemy is moved to another slot or removed from the pool.
+ *
+ * @param slot  The slot of the enemy to remove.
+ */
+void RemoveEnemyFromHash(int slot);
+
+/**
+ * Moves the enemy in a slot of the pool to the bucket of its current tile cell after it moved.
+ *
+ * @param slot  The slot of the enemy to update.
+ *
+ * ? @note Does nothing if the enemy is still in the same tile cell.
+ */
+void UpdateEnemyInHash(int slot);
+
+/**
+ * Empties all the buckets of the enemy spatial hash.
+ *
+ * ! @attention Must be called before the first enemy is inserted.
+ */
+void ClearEnemyHash();
+
+/**
+ * Lists the enemies whose hitbox overlaps the given rectangle.
+ *
+ * @param rec           Rectangle in world coordinates.
+ * @param results       Array that will receive the slots of the enemies.
+ * @param maxResults    Size of the results array.
+ * @returns             Number of enemies found, which can be more than maxResults. Only the
+ *                      first maxResults are written to the results array.
+ *
+ * ? @note Reads enemies.hitboxes, which do not change while the enemies are updated in
+ *         parallel, so the workers can call it.
+ * ? @note The slots are only valid until the next enemy is removed from the pool.
+ */
+int QueryEnemiesInRect(Rectangle rec, int results[], int maxResults);
+
+/**
+ * Lists the enemies whose position is within a radius of the given point.
+ *
+ * @param center        Center of the search in world coordinates.
+ * @param radius        Radius of the search in pixels.
+ * @param results       Array that will receive the slots of the enemies.
+ * @param maxResults    Size of the results array.
+ * @returns             Number of enemies found, which can be more than maxResults. Only the
+ *                      first maxResults are written to the results array.
+ *
+ * ? @note Uses the same distance as Vector2Distance between the positions.
+ * ? @note The slots are only valid until the next enemy is removed from the pool.
+ */
+int QueryEnemiesInRadius(Vector2 center, float radius, int results[], int maxResults);
+
+/**
+ * Lists all the enemies whose hitbox overlaps the given rectangle, growing the query as needed.
+ *
+ * @param rec       Rectangle in world coordinates.
+ * @param query     Query that will receive the slots of the enemies.
+ *
+ * ! @attention Grows the query with realloc, so it must not be shared between threads.
+ */
+void CollectEnemiesInRect(Rectangle rec, EnemyQuery* query);
+
+/**
+ * Lists all the enemies whose position is within a radius of the given point, growing the
+ * query as needed.
+ *
+ * @param center    Center of the search in world coordinates.
+ * @param radius    Radius of the search in pixels.
+ * @param query     Query that will receive the slots of the enemies.
+ *
+ * ! @attention Grows the query with realloc, so it must not be shared between threads.
+ */
+void CollectEnemiesInRadius(Vector2 center, float radius, EnemyQuery* query);
+
+/**
+ * Frees the slots of a query and resets it to zero.
+ *
+ * @param query Query to unload.
+ */
+void UnloadEnemyQuery(EnemyQuery* query);
+
+#endif // ENEMY_HASH_H_
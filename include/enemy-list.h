@@ -14,76 +14,240 @@
 
 #include "enemy.h"
 
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Initial number of enemies the pool has room for, it doubles every time it is full. */
+#define ENEMY_POOL_INITIAL_CAPACITY 64
+
+/**
+ * Distance (pixels) from the player up to which enemies are simulated every frame. Covers the
+ * visible area around the player at the camera zoom (half diagonal of about 184 pixels).
+ */
+#define ENEMY_FULL_RATE_RANGE 240
+
+/** Enemies further away are simulated once every this many frames, with the time they skipped. */
+#define ENEMY_REDUCED_RATE_INTERVAL 4
+
+/** Number of updates between the checks of the order of the enemies in the pool. */
+#define ENEMY_SORT_INTERVAL 120
+
+/**
+ * The pool is sorted when more than one in this many pairs of consecutive enemies of the same
+ * type are out of order (a shuffled pool has about half of them out of order).
+ */
+#define ENEMY_SORT_DISORDER 8
+
+//* ------------------------------------------
+//* ENUMERATIONS
+
+/**
+ * Level of detail at which an enemy is simulated.
+ *
+ * @param ENEMY_LOD_FULL    Simulated every frame, near the player.
+ * @param ENEMY_LOD_REDUCED Simulated every ENEMY_REDUCED_RATE_INTERVAL frames with a larger step.
+ * @param ENEMY_LOD_ASLEEP  Not simulated, in a room the player has not reached yet.
+ */
+typedef enum EnemyLod {
+    ENEMY_LOD_FULL = 0,
+    ENEMY_LOD_REDUCED,
+    ENEMY_LOD_ASLEEP
+} EnemyLod;
+
 //* ------------------------------------------
 //* STRUCTURES
 
 /**
- * EnemyNode struct represents an enemy who has a reference to another enemy.
+ * Stable reference to an enemy of the pool, it stays valid while the enemy moves between slots.
  *
- * @param enemy         Enemy entity of this node.
- * @param type          Enemy type of this node.
- * @param lastPlayerPos Last known location of player to this enemy.
- * @param hasAttacked   Indicates if this enemy has attacked.
- * @param next          Next enemy node.
+ * @param id            Index of the enemy in the handle table of the pool.
+ * @param generation    Generation of the id when the handle was made. The handle is stale once
+ *                      the enemy is removed and its id reused.
  */
-typedef struct EnemyNode EnemyNode;
-struct EnemyNode {
-    /** The enemy entity. */
-    Entity enemy;
-    /** The enemy type. */
-    EnemyType type;
-    /** The last known location of player relative to this enemy. */
-    Vector2 lastPlayerPos;
-    /** Indicates if this enemy has attacked. */
-    bool hasAttacked;
-    /** The pointer to the next enemy entity. */
-    EnemyNode* next;
-};
+typedef struct EnemyHandle {
+    int id;
+    unsigned int generation;
+} EnemyHandle;
+
+/**
+ * Pool of all the enemies stored as parallel arrays (structure of arrays). The enemies are kept
+ * packed in the slots [0, size), so iterating them is a linear walk over each array.
+ *
+ * @param size                  Number of enemies in the pool.
+ * @param capacity              Number of slots allocated in each array.
+ * @param typeStarts            First slot of the enemies of each EnemyType. The enemies of a type
+ *                              are in [typeStarts[type], typeStarts[type + 1]), and
+ *                              typeStarts[MAX_ENEMY_TYPES] is the size of the pool.
+ * @param entities              Entity of each enemy.
+ * @param positions             Position of each enemy, read by the scans over the pool.
+ * @param hitboxes              Hitbox of each enemy, read by the scans over the pool.
+ * @param types                 Enemy type of each enemy.
+ * @param lastPlayerPositions   Last known location of player to each enemy.
+ * @param spawnPositions        Position each enemy was spawned at.
+ * @param homePaths             Path each enemy follows back to its spawn position.
+ * @param animations            Playback state of the animations of each enemy.
+ * @param hasAttacked           Indicates if each enemy has attacked.
+ * @param isPlayerNear          Indicates if the player is within AGRO_RANGE of each enemy.
+ * @param isPlayerSeen          Indicates if the player is near and in the line of sight of each enemy.
+ * @param isHittingPlayer       Indicates if the attack of each enemy hit the player this step.
+ * @param snapshot              Copy of the entities taken before they are updated in parallel.
+ * @param isAwake               Indicates if each enemy woke up, awake enemies never sleep again.
+ * @param pendingTimes          Time (seconds) each enemy at reduced rate has not been simulated for.
+ * @param stepTimes             Duration of the simulation step of each enemy on this update (0 if skipped).
+ * @param reachedRegions        Indicates for each region of roomRegions if the player has been there.
+ *                              The enemies of a room are spawned the first time it is reached.
+ * @param numOfPendingEnemies   Number of enemies of the regions not reached yet, not spawned but
+ *                              still alive for AreEnemiesDefeated.
+ * @param numOfUpdates          Number of updates done, staggers the enemies at reduced rate.
+ * @param sortKeys              Morton code of the tile cell of each enemy, used to sort the pool.
+ * @param sortSlots             Slots of the enemies of the pool in sorted order.
+ * @param cellsX                Horizontal (x) tile cell of each enemy in the spatial hash.
+ * @param cellsY                Vertical (y) tile cell of each enemy in the spatial hash.
+ * @param nextInCell            Slot of the next enemy in the same bucket of the spatial hash (-1 if none).
+ * @param ids                   Id of the handle table of each enemy.
+ * @param idSlots               Slot of the enemy of each id (-1 if the id is free).
+ * @param idGenerations         Current generation of each id.
+ * @param freeIds               Stack of the ids that can be reused.
+ * @param numOfFreeIds          Number of ids in the freeIds stack.
+ *
+ * ? @note The pool is partitioned by EnemyType, so each type is updated and rendered by its own
+ *         loop with the behaviour of the type looked up once (see EnemyBehaviour).
+ * ? @note Enemies are removed by moving the last enemy of their type into their slot, and the
+ *         last enemy of each following type one slot back, so the partitions stay packed. The
+ *         same happens the other way around when an enemy is added. Slots are only valid until
+ *         the next addition or removal, use an EnemyHandle to keep a reference.
+ * ? @note Each partition is sorted now and then by the Morton (Z-order) code of the tile cell of
+ *         its enemies, so enemies close in the world are also close in memory (see UpdateEnemies).
+ * ? @note The positions and hitboxes are kept in their own arrays, so the spatial hash, its
+ *         queries, the sort and the level of detail only walk the data they read. They are
+ *         only written on the main thread (see StoreEnemyBody), so they stay frozen while the
+ *         enemies are updated in parallel.
+ * ? @note The Entity still holds the position and hitbox the entity functions shared with the
+ *         player move, the arrays are copied from it.
+ */
+typedef struct EnemyPool {
+    /** Number of enemies in the pool. */
+    int size;
+    /** Number of slots allocated in each array. */
+    int capacity;
+    /** Partitions by type. */
+    int typeStarts[MAX_ENEMY_TYPES + 1];
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    Entity* entities;
+    Vector2* positions;
+    Rectangle* hitboxes;
+    EnemyType* types;
+    Vector2* lastPlayerPositions;
+    Vector2* spawnPositions;
+    PathFollower* homePaths;
+    EnemyAnimations* animations;
+    bool* hasAttacked;
+    /** Set by UpdateEnemies. */
+    bool* isPlayerNear;
+    bool* isPlayerSeen;
+    bool* isHittingPlayer;
+    /** Neighbours read by the parallel update instead of the entities being written. */
+    Entity* snapshot;
+    /** Simulation level of detail. */
+    bool* isAwake;
+    float* pendingTimes;
+    float* stepTimes;
+    bool* reachedRegions;
+    int numOfPendingEnemies;
+    unsigned int numOfUpdates;
+    /** Storage order. */
+    unsigned int* sortKeys;
+    int* sortSlots;
+    /** Spatial hash data (see enemy-hash.h). */
+    int* cellsX;
+    int* cellsY;
+    int* nextInCell;
+    /** Handle table. */
+    int* ids;
+    int* idSlots;
+    unsigned int* idGenerations;
+    int* freeIds;
+    int numOfFreeIds;
+} EnemyPool;
 
 //* ------------------------------------------
 //* GLOBAL VARIABLES
 
-/** The list of all enemies. */
-extern EnemyNode* enemies;
+/** The pool of all enemies. */
+extern EnemyPool enemies;
 
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
 /**
- * Unloads the list of enemies.
+ * Unloads all the enemies of the pool.
  *
- * ! @attention Exits the program if the list of enemies is not found.
- * ! @note Unallocates memory for each EntityNode.
+ * ! @note Unallocates memory for the arrays of the pool.
  */
 void UnloadEnemies();
 
 /**
- * Populates the enemies linked list by creates entities around the level and
- * assigning them to an EnityNode.
+ * Prepares the pool of enemies. The enemies of each room are only created when the player
+ * enters the room for the first time (see UpdateEnemies).
+ *
+ * ! @attention Needs roomRegions to be built, its regions are the rooms entered.
+ *
+ * ? @note Calls LoadEnemyAnimations, so the textures must be loaded first.
+ * ? @note Rooms outside of every region, or whose region has no tiles (it can never be entered),
+ *         have their enemies created right away.
  */
 void SetupEnemies();
 
+/**
+ * Checks if every enemy of the dungeon was defeated, including the ones of the rooms the
+ * player has not entered yet.
+ *
+ * @returns True if no enemy is alive or waiting to be spawned, false otherwise.
+ */
+bool AreEnemiesDefeated();
+
 /**
  * Updates information required to move enemies and handle their attacks.
  * 
  * ! @attention Does not update enemies if the player has expired it's health points.
+ *
+ * @param deltaTime Duration of the simulation step in seconds.
  * 
- * ? @note Calls MoveEnemies and HandleEnemiesAttack.
+ * ? @note Enemies with less than or zero (0) health points are removed first.
+ * ? @note Every ENEMY_SORT_INTERVAL updates, the order of the pool is checked and the enemies
+ *         are sorted by tile cell if it passed ENEMY_SORT_DISORDER.
+ * ? @note Enemies are simulated at a level of detail (see EnemyLod). Enemies sleep until the
+ *         player reaches their room or they are damaged, and the ones awake but far from the
+ *         player are only simulated every ENEMY_REDUCED_RATE_INTERVAL frames.
+ * ? @note The enemies are updated in two phases. MoveEnemies and HandleEnemiesAttack run in
+ *         parallel on the workerPool, reading the other enemies from a snapshot and the player
+ *         without writing to it. Then the damage to the player is applied on the main thread.
  */
-void UpdateEnemies();
+void UpdateEnemies(float deltaTime);
 
 /**
- * Handles rendering each enemt in the list of enemies.
+ * Handles rendering each enemy of the pool.
  *
- * ? @note Calls EnemyRender on each enemy (see enemy.c).
+ * ? @note Calls EnemyRender on each enemy (see enemy.c), one type at a time.
  */
 void RenderEnemies();
 
 /**
- * Deletes all enemies on the list that have less than or zero (0) health points.
- * 
- * ? @note May change enemies list to NULL (empty)
+ * Gets a stable handle to the enemy in a slot of the pool.
+ *
+ * @param slot  Slot of the enemy.
+ * @returns     The handle of the enemy.
+ */
+EnemyHandle GetEnemyHandle(int slot);
+
+/**
+ * Gets the current slot of the enemy of a handle.
+ *
+ * @param handle    Handle of the enemy.
+ * @returns         The slot of the enemy, or -1 if the enemy was removed.
  */
-void CleanUpEnemies();
+int GetEnemySlot(EnemyHandle handle);
 
 #endif // ENEMY_LIST_H_
\ No newline at end of file
@@ -0,0 +1,79 @@
+/***********************************************************************************************
+ *
+ **   Provides definitions for the storage of the enemy pool: growing its arrays, moving enemies
+ **   between slots and sorting them by the Morton code of their tile cell.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include enemy-list.h
+ *
+ *    ? @note Only touches the arrays of the pool and the spatial hash, so it can be linked
+ *            without the rest of the game (see tests/enemy-sort-bench.c).
+ *
+ ***********************************************************************************************/
+
+#ifndef ENEMY_POOL_H_
+#define ENEMY_POOL_H_
+
+#include "enemy-list.h"
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Reallocates all the arrays of the pool with a new capacity.
+ *
+ * @param capacity  The new number of slots.
+ *
+ * ? @note The ids of the new slots are pushed on the freeIds stack.
+ */
+void ResizeEnemyPool(int capacity);
+
+/**
+ * Copies the enemy in a slot of the pool to another slot and updates its handle.
+ *
+ * ! @attention Does not update the spatial hash, the slots in it must be fixed by the caller.
+ *
+ * @param from  Slot of the enemy to copy.
+ * @param to    Slot the enemy is copied to.
+ */
+void CopyEnemySlot(int from, int to);
+
+/**
+ * Sorts the enemies of each partition of the pool by the Morton code of their tile cell, if
+ * more than one in ENEMY_SORT_DISORDER of them are out of order.
+ *
+ * @returns True if the pool was sorted, false if it was ordered enough to be left as is.
+ *
+ * ? @note Rebuilds the spatial hash, with the enemies of each bucket in the order of the pool.
+ * ? @note The handles of the enemies stay valid.
+ */
+bool SortEnemies();
+
+/**
+ * Moves the enemies of the slots [first, last) to the order given by enemies.sortSlots.
+ *
+ * @param first First slot of the range.
+ * @param last  Slot after the last one of the range.
+ *
+ * ! @attention Uses the slot enemies.size as temporary storage, the pool must have room for it.
+ * ! @attention Does not update the spatial hash, the slots in it must be fixed by the caller.
+ */
+void PermuteEnemies(int first, int last);
+
+/**
+ * Returns the Morton (Z-order) code of a tile cell, interleaving the bits of its coordinates.
+ *
+ * @param cellX Horizontal (x) tile coordinate.
+ * @param cellY Vertical (y) tile coordinate.
+ * @returns     The Morton code of the cell.
+ */
+unsigned int GetMortonCode(int cellX, int cellY);
+
+/**
+ * Frees all the arrays of the pool and resets it to zero.
+ */
+void UnloadEnemyPool();
+
+#endif // ENEMY_POOL_H_
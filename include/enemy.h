@@ -5,7 +5,7 @@
  *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
  *    @version 0.3
  *
- *    @include entity.h
+ *    @include entity.h, path-cache.h, path-planner.h
  *
  ***********************************************************************************************/
 
@@ -13,6 +13,8 @@
 #define ENEMY_H_
 
 #include "entity.h"
+#include "path-cache.h"
+#include "path-planner.h"
 
 //* ------------------------------------------
 //* DEFINITIONS
@@ -50,25 +52,134 @@
 #define ENEMY_WAFFLES_ATTACK_WIDTH  96
 #define ENEMY_WAFFLES_ATTACK_HEIGHT 96
 
+/**
+ * List of every enemy archetype (X-macro). Expands X once per archetype with its properties, so
+ * the EnemyType enum and the enemyArchetypes table are generated from a single place.
+ *
+ * X(type, width, height, attackWidth, attackHeight, idleTile, health, speed, loadAttackHitbox,
+ *   renderAttack)
+ *
+ * ? @note To add an archetype, add a line here and its textures in order (idle, move, attack)
+ *         starting at idleTile in the TextureFile enum.
+ * ? @note loadAttackHitbox and renderAttack name the functions of the EnemyBehaviour of the
+ *         archetype (see enemy.c).
+ */
+#define ENEMY_ARCHETYPES(X)                                                                    \
+    X(DEMON_PABLO, ENEMY_PABLO_WIDTH, ENEMY_PABLO_HEIGHT, ENEMY_PABLO_ATTACK_WIDTH,            \
+      ENEMY_PABLO_ATTACK_HEIGHT, TILE_ENEMY_PABLO_IDLE, ENEMY_PABLO_HEALTH, ENEMY_PABLO_SPEED, \
+      LoadStandardEntityAttackHitbox, RenderPabloDiegoAttack)                                  \
+    X(DEMON_DIEGO, ENEMY_DEIGO_WIDTH, ENEMY_DEIGO_HEIGHT, ENEMY_DEIGO_ATTACK_WIDTH,            \
+      ENEMY_DEIGO_ATTACK_HEIGHT, TILE_ENEMY_DIEGO_IDLE, ENEMY_DIEGO_HEALTH, ENEMY_DIEGO_SPEED, \
+      LoadStandardEntityAttackHitbox, RenderPabloDiegoAttack)                                  \
+    X(DEMON_WAFFLES, ENEMY_WAFFLES_WIDTH, ENEMY_WAFFLES_HEIGHT, ENEMY_WAFFLES_ATTACK_WIDTH,    \
+      ENEMY_WAFFLES_ATTACK_HEIGHT, TILE_ENEMY_WAFFLES_IDLE, ENEMY_WAFFLES_HEALTH,              \
+      ENEMY_WAFFLES_SPEED, LoadWafflesAttackHitbox, RenderWafflesAttack)
+
 //* ------------------------------------------
 //* ENUMERATIONS
 
 /**
  * Enum to treat different enemies based on their type.
  *
- * @param DEMON_PABLO   0
- * @param DEMON_DIEGO   1
- * @param DEMON_WAFFLES 2
+ * @param DEMON_PABLO       0
+ * @param DEMON_DIEGO       1
+ * @param DEMON_WAFFLES     2
+ * @param MAX_ENEMY_TYPES   Number of enemy types.
+ *
+ * ? @note Generated from ENEMY_ARCHETYPES.
  */
 typedef enum EnemyType {
-    DEMON_PABLO = 0,
-    DEMON_DIEGO,
-    DEMON_WAFFLES
+#define ENEMY_TYPE_ENUM(type, ...) type,
+    ENEMY_ARCHETYPES(ENEMY_TYPE_ENUM)
+#undef ENEMY_TYPE_ENUM
+    MAX_ENEMY_TYPES
 } EnemyType;
 
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Immutable properties of an enemy archetype.
+ *
+ * @param width         Width of the sprite.
+ * @param height        Height of the sprite.
+ * @param attackWidth   Width of the attack sprite.
+ * @param attackHeight  Height of the attack sprite.
+ * @param idleTile      TextureFile of the idle animation, followed by the move and attack ones.
+ * @param health        Initial health points.
+ * @param speed         Movement speed.
+ */
+typedef struct EnemyArchetype {
+    int width;
+    int height;
+    int attackWidth;
+    int attackHeight;
+    int idleTile;
+    int health;
+    int speed;
+} EnemyArchetype;
+
+/**
+ * Playback state of the animations of a single enemy. The animation data itself is shared by
+ * all the enemies of the same EnemyType (see LoadEnemyAnimations).
+ *
+ * @param states    State of each animation. Access it through the AnimationType enum.
+ */
+typedef struct EnemyAnimations {
+    AnimationState states[MAX_ENEMY_ANIMATIONS];
+} EnemyAnimations;
+
+/**
+ * Functions and constants specialised for an EnemyType. The enemies are updated and rendered
+ * in batches of the same type, so the behaviour is looked up once per batch instead of
+ * switching on the type for every enemy.
+ *
+ * @param type              Type of enemy.
+ * @param archetype         Properties of the type (see enemyArchetypes).
+ * @param animations        Animation descriptors of the type. Access it through the AnimationType enum.
+ * @param loadAttackHitbox  Updates the attack hitbox of an enemy of the type.
+ * @param renderAttack      Renders the attack animation of an enemy of the type.
+ */
+typedef struct EnemyBehaviour {
+    EnemyType type;
+    const EnemyArchetype* archetype;
+    const AnimationDescriptor* animations;
+    void (*loadAttackHitbox)(Entity* enemy);
+    void (*renderAttack)(Entity* enemy, const struct EnemyBehaviour* behaviour, EnemyAnimations* animations);
+} EnemyBehaviour;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Properties of every enemy archetype, indexed by EnemyType (see enemy-utils.c). */
+extern const EnemyArchetype enemyArchetypes[MAX_ENEMY_TYPES];
+
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
+/**
+ * Creates the animation descriptors of every EnemyType, shared by all the enemies.
+ *
+ * ! @attention Must be called after the textures are loaded and before rendering any enemy.
+ * ! @note Allocates memory for the frames of each descriptor. Must be freed with UnloadEnemyAnimations.
+ */
+void LoadEnemyAnimations();
+
+/**
+ * Frees the animation descriptors created by LoadEnemyAnimations.
+ */
+void UnloadEnemyAnimations();
+
+/**
+ * Returns the behaviour of the given enemy type.
+ *
+ * ! @attention returns the behaviour of DEMON_PABLO if given an invalid type.
+ *
+ * @param type  The enemy type.
+ * @returns     A pointer to the shared behaviour of the type.
+ */
+const EnemyBehaviour* GetEnemyBehaviour(EnemyType type);
+
 /**
  * Creates an instance of an enemy with the given position and type and returns
  * it. Starts any timers that need to run forever.
@@ -84,17 +195,37 @@ typedef enum EnemyType {
 Entity EnemyStartup(Vector2 position, EnemyType type);
 
 /**
- * Handles enemy movement of the given enemy and updates it's GameState and Direction.
+ * Resets the playback state of an enemy's animations and starts the timers that run forever.
  *
- * ! @attention returns when given a NULL enemy reference.
+ * @param animations    The animations state of the enemy.
+ *
+ * ? @note Does not allocate memory, the animation data is shared (see LoadEnemyAnimations).
+ */
+void StartEnemyAnimations(EnemyAnimations* animations);
+
+/**
+ * Handles enemy movement of the given enemy and updates it's GameState and Direction. The enemy
+ * is only steered, the caller moves it (see SteerEntityTowardsPos).
+ *
+ * ! @attention returns false when given a NULL enemy reference.
  *
  * @param enemy         The enemy to handle movement.
  * @param lastPlayerPos The last known location of the player.
+ * @param spawnPos      The position the enemy walks back to after checking lastPlayerPos.
+ * @param homePath      The path follower of the enemy walking back to spawnPos.
  * @param type          Type of enemy.
+ * @param isPlayerSeen  Indicates if the player is in AGRO_RANGE and in the line of sight of the enemy.
+ * @param planner       Work arrays of the path searches of the thread running the enemy.
+ * @returns             True if the enemy moves this step in its direction, false otherwise.
  *
  * ? @note Needs a reference to the lastPlayerPos of the given enemy.
+ * ? @note The line of sight of all enemies is checked at once (see UpdateEnemies).
+ * ? @note Can run on several enemies in parallel, each thread with its own planner. Only the
+ *         reads and writes of the path cache are serialized by its lock.
  */
-void EnemyMovement(Entity* enemy, Vector2* lastPlayerPos, EnemyType type);
+bool EnemyMovement(
+    Entity* enemy, Vector2* lastPlayerPos, Vector2 spawnPos, PathFollower* homePath, EnemyType type,
+    bool isPlayerSeen, PathPlanner* planner);
 
 /**
  * Handles the given enemy's attack.
@@ -102,33 +233,62 @@ void EnemyMovement(Entity* enemy, Vector2* lastPlayerPos, EnemyType type);
  * ! @attention returns if the enemy is NULL, has an invalid state or if it is no longer attacking.
  *
  * @param enemy         The reference to the enemy to handle the attack for.
- * @param type          Type of enemy.
+ * @param behaviour     Behaviour of the type of the enemy.
+ * @param animations    The animations state of the enemy.
  * @param hasAttacked   Indicates if this enemy has attacked.
+ * @param isHittingPlayer Set to true when the attack of the enemy hits the player this step.
+ * @param isPlayerNear  Indicates if the player is within AGRO_RANGE of the enemy.
  *
  * ? @note Manages the timer for the enemy attack animation.
- * ? @note Calls UpdateEnemyAttackHitbox to update the given enemy's attack hotbox.
- * ? @note Calls EntityAttack to handle and check enemy attack if the hitboxes intersect.
+ * ? @note Calls the loadAttackHitbox of the behaviour to update the given enemy's attack hitbox.
+ * ? @note Only reads the player, so it can run on several enemies in parallel. The damage is
+ *         applied afterwards by CommitEnemyAttack.
  */
-void EnemyAttack(Entity* enemy, EnemyType type, bool* hasAttacked);
+void EnemyAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations, bool* hasAttacked,
+    bool* isHittingPlayer, bool isPlayerNear);
+
+/**
+ * Applies the damage of an enemy attack that hit the player (see EnemyAttack).
+ *
+ * ! @attention Must be called from a single thread.
+ *
+ * @param enemy The enemy whose attack hit the player.
+ *
+ * ? @note Calls EntityAttack.
+ */
+void CommitEnemyAttack(Entity* enemy);
+
+/**
+ * Returns the center of the given enemy's sprite, used as the eyes of the enemy.
+ *
+ * @param enemy The enemy to get the center of.
+ * @param type  Type of enemy.
+ * @returns     The center of the enemy in world coordinates.
+ */
+Vector2 GetEnemyCenter(Entity* enemy, EnemyType type);
 
 /**
  * Renders the enemy animation based off of it's GameState.
  *
  * ! @attention returns if the enemy is NULL or has an invalid state.
  *
- * @param enemy The reference to the enemy to render.
- * @param type  Type of enemy.
+ * @param enemy         The reference to the enemy to render.
+ * @param behaviour     Behaviour of the type of the enemy.
+ * @param animations    The animations state of the enemy.
+ *
+ * ? @note Calls the renderAttack of the behaviour while the enemy is attacking.
  */
-void EnemyRender(Entity* enemy, EnemyType type);
+void EnemyRender(Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations);
 
 /**
- * Unloads all the enemies and animations associated with an enemy entity.
+ * Unloads an enemy entity.
  *
  * ! @attention exits the program if given a NULL enemy reference.
  *
- * @param enemy The reference to the enemy to render.
+ * @param enemy The reference to the enemy to unload.
  *
- * ! @note Unallocates memory for the array in enemy.animations.
+ * ? @note The shared animations are unloaded with UnloadEnemyAnimations.
  */
 void EnemyUnload(Entity* enemy);
 
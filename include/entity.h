@@ -71,6 +71,7 @@ typedef enum Direction {
  * Structure to represent an entity (player / enemy).
  *
  * @param pos            The x and y position of the entity as a vector.
+ * @param prevPos        The position of the entity at the start of the last simulation step.
  * @param speed          Scalar speed
  * @param health         Health points
  * @param faceValue      Entity is turned to right or left
@@ -88,6 +89,8 @@ typedef enum Direction {
 typedef struct Entity {
     /** The position of the entity. */
     Vector2 pos;
+    /** The position of the entity before the last simulation step (used to interpolate rendering). */
+    Vector2 prevPos;
     /** The hitbox used for collision detection.
      *  @note Position needs to be updated everytime we use it
      */
@@ -106,6 +109,7 @@ typedef struct Entity {
     Direction directionFace;
     /** Array struct with all the animations this entity has.
      * @note Use AnimationType enum to access a specific animation in the array
+     * @note Empty on enemies, their animations are shared per EnemyType (see EnemyAnimations).
      */
     AnimationArray animations;
     /** Struct that represents the attack hitbox of this entity. */
@@ -126,13 +130,51 @@ extern Entity player;
  *
  * ! @attention Returns if given a NULL entity.
  *
- * @param entity        The reference to the entity to move.
+ * @param entity           The reference to the entity to move.
+ * @param position         The position to move the entity towards.
+ * @param lastPlayerPos    The last known position of the player relative to an enemy entity.
+ * @param neighbours       Entities close enough to block this movement.
+ * @param numOfNeighbours  Number of entities in the neighbours array.
+ * @param deltaTime        Duration of the simulation step in seconds.
+ *
+ * ? @note pass NULL to lastPlayerPos if the entity is not an enemy.
+ * ? @note pass NULL and 0 to neighbours and numOfNeighbours if no entity can block the movement.
+ * ? @note Calls SteerEntityTowardsPos, normalises the direction and scales it by the speed, then
+ *         calls CollideEntity and moves the entity. Many entities can run these steps in
+ *         batches instead, with the kinematics functions (see kinematics.h).
+ */
+void MoveEntityTowardsPos(
+    Entity* entity, Vector2 position, Vector2* lastPlayerPos, Entity* neighbours[],
+    int numOfNeighbours, float deltaTime);
+
+/**
+ * Sets the direction, directionFace, faceValue and state of an entity moving towards a given
+ * position, without moving it. First step of MoveEntityTowardsPos.
+ *
+ * ! @attention Returns false if given a NULL entity.
+ *
+ * @param entity        The reference to the entity to steer.
  * @param position      The position to move the entity towards.
  * @param lastPlayerPos The last known position of the player relative to an enemy entity.
+ * @returns             True if the entity moves this step, false if it stays (zero position or attacking).
  *
  * ? @note pass NULL to lastPlayerPos if the entity is not an enemy.
  */
-void MoveEntityTowardsPos(Entity* entity, Vector2 position, Vector2* lastPlayerPos);
+bool SteerEntityTowardsPos(Entity* entity, Vector2 position, Vector2* lastPlayerPos);
+
+/**
+ * Clips the velocity of a steered entity against the world and its neighbours and updates its
+ * state. Step of MoveEntityTowardsPos between the normalisation of the direction and the move.
+ *
+ * @param entity           The reference to the entity, its direction must be its velocity.
+ * @param lastPlayerPos    The last known position of the player relative to an enemy entity.
+ * @param neighbours       Entities close enough to block this movement.
+ * @param numOfNeighbours  Number of entities in the neighbours array.
+ * @param deltaTime        Duration of the simulation step in seconds.
+ */
+void CollideEntity(
+    Entity* entity, Vector2* lastPlayerPos, Entity* neighbours[], int numOfNeighbours,
+    float deltaTime);
 
 /**
  * Responsible for rendering the entity with the specified animation.
@@ -153,6 +195,26 @@ void EntityRender(
     Entity* entity, Animation* animation, int entityWidth, int entityHeight,
     int xOffset, int yOffset, float rotation);
 
+/**
+ * Responsible for rendering the entity with a shared animation and its own playback state.
+ *
+ * ! @attention returns if given either a NULL entity, descriptor or state.
+ *
+ * @param entity        Pointer to the entity to render.
+ * @param descriptor    Shared data of the animation to apply to the entity.
+ * @param state         Playback state of the animation for this entity.
+ * @param entityWidth   Width of the entity.
+ * @param entityHeight  Height of the entity.
+ * @param xOffset       X-direction pixel offset from the current x of the entity.
+ * @param yOffset       Y-direction pixel offset from the current y of the entity.
+ * @param rotation      Rotation amount as a float.
+ *
+ * ? @note Same as EntityRender, see DrawAnimationState.
+ */
+void EntityRenderState(
+    Entity* entity, const AnimationDescriptor* descriptor, AnimationState* state,
+    int entityWidth, int entityHeight, int xOffset, int yOffset, float rotation);
+
 //* Entity collision logic
 
 /**
@@ -183,13 +245,14 @@ void UpdateEntityHitbox(Entity* entity);
  *
  * @param entity        Moving entity to test the collision
  * @param hitboxTarget  Rectangle that the entity will check a collision with
+ * @param deltaTime     Duration of the simulation step in seconds
  * @return              Information about the collision.
  *
  * ? @note - Important to check the timeHit (-n, -1, 0, +1 or +n) of the returned collision
  *              even if the collision.hit is true.
  * ? @note - Resolving the collision is still necessary. This function is only for detection.
  */
-RayCollision2D EntityRectCollision(Entity entity, Rectangle hitboxTarget);
+RayCollision2D EntityRectCollision(Entity entity, Rectangle hitboxTarget, float deltaTime);
 
 /**
  * Function used to check if there was a collision between a moving entity and another
@@ -199,22 +262,52 @@ RayCollision2D EntityRectCollision(Entity entity, Rectangle hitboxTarget);
  *
  * @param entityIn      Moving entity to test the collision
  * @param entityTarget  Target entity that the entityIn will check a collision with
+ * @param deltaTime     Duration of the simulation step in seconds
  * @return              Information about the collision.
  *
  * ? @note - Important to check the timeHit (-n, -1, 0, +1 or +n) of the returned collision
  *              even if the collision.hit is true.
  * ? @note - Resolving the collision is still necessary. This function is only for detection.
  */
-RayCollision2D EntitiesCollision(Entity entityIn, Entity entityTarget);
+RayCollision2D EntitiesCollision(Entity entityIn, Entity entityTarget, float deltaTime);
 
 /**
- * Handles entity collision with the world tilemap(Tile**) through the collidableTiles list.
+ * Handles entity collision with the world tilemap through the collisionGrid.
  *
  * ! @attention Use this only for general entities (16x32 with only the lower 16pxls collidable)
  *
- * @param entity Pointer to the entity that will check collision with all the collidable tiles on the map
+ * @param entity    Pointer to the entity that will check collision with the solid tiles around it
+ * @param deltaTime Duration of the simulation step in seconds
+ */
+void EntityWorldCollision(Entity* entity, float deltaTime);
+
+/**
+ * Handles entity collision with the entities around it, making it slide along them.
+ *
+ * @param entity            Pointer to the entity that will check collision with its neighbours
+ * @param neighbours        Entities close to the given entity (from a broad phase)
+ * @param numOfNeighbours   Number of entities in the neighbours array
+ * @param deltaTime         Duration of the simulation step in seconds
+ *
+ * ? @note Uses EntitiesCollision for each neighbour. Entities already overlapping are not
+ *         moved apart here, see SeparateEntity.
+ */
+void EntityNeighboursCollision(
+    Entity* entity, Entity* neighbours[], int numOfNeighbours, float deltaTime);
+
+/**
+ * Pushes an entity out of the neighbours its hitbox overlaps, along the axis of least overlap.
+ *
+ * @param entity            Pointer to the entity to separate
+ * @param neighbours        Entities close to the given entity (from a broad phase)
+ * @param numOfNeighbours   Number of entities in the neighbours array
+ *
+ * ? @note Each entity only moves half of the overlap, the other half is done by the neighbour.
+ * ? @note The entity is not pushed into solid tiles of the collisionGrid.
+ * ? @note Entities on the exact same spot are split by their prevPos, so the neighbours can be
+ *         copies of the entities (see UpdateEnemies).
  */
-void EntityWorldCollision(Entity* entity);
+void SeparateEntity(Entity* entity, Entity* neighbours[], int numOfNeighbours);
 
 /**
  * Sets the attack hitbox for the entities of standard size.
@@ -0,0 +1,96 @@
+/**********************************************************************************************
+ *
+ **   field-of-view.h is responsible for defining a field of view bitmap computed from a single
+ **   tile with symmetric shadowcasting, so many viewers can be checked against it at once.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include collision-grid.h
+ *    @cite Symmetric Shadowcasting (Albert Ford)
+ *
+ **********************************************************************************************/
+
+#ifndef FIELD_OF_VIEW_H
+#define FIELD_OF_VIEW_H
+
+#include "collision-grid.h"
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Bitmap with the tiles visible from an origin tile.
+ *
+ * @param width         Width of the map in tiles
+ * @param height        Height of the map in tiles
+ * @param originX       Horizontal (x) coordinate of the tile the view was computed from
+ * @param originY       Vertical (y) coordinate of the tile the view was computed from
+ * @param radius        Max distance in tiles from the origin that was computed
+ * @param visibleBits   Bitmap of width * height bits. The bit of a tile is set if it is visible.
+ *
+ * ? @note Visibility is symmetric: if a tile is visible from the origin, the origin is
+ *         visible from that tile.
+ */
+typedef struct FieldOfView {
+    /** Width of the map in tiles. */
+    int width;
+    /** Height of the map in tiles. */
+    int height;
+    /** Tile the view was computed from. */
+    int originX;
+    int originY;
+    /** Max distance in tiles from the origin that was computed. */
+    int radius;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major bitmap with the visibility of each tile.
+     */
+    unsigned char* visibleBits;
+} FieldOfView;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Field of view from the tile of the player, shared by all the enemies. */
+extern FieldOfView playerView;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates the playerView with the given dimensions and with no visible tiles.
+ *
+ * ! @note Allocates memory for the bitmap. Must be freed with UnloadFieldOfView.
+ *
+ * @param width     Width of the map in tiles
+ * @param height    Height of the map in tiles
+ */
+void CreateFieldOfView(int width, int height);
+
+/**
+ * Recomputes the playerView from the tile of the given point, using the collisionGrid walls.
+ *
+ * @param origin    Point in world coordinates the view is computed from
+ * @param radius    Max distance in tiles from the origin (square range)
+ *
+ * ? @note Does nothing if the origin is still in the same tile and the radius did not change.
+ * ? @note Costs O(visible area), only the tiles of the previous view are cleared.
+ */
+void UpdateFieldOfView(Vector2 origin, int radius);
+
+/**
+ * Checks if the tile of a point is visible in the playerView.
+ *
+ * @param pos   Point in world coordinates
+ * @return      True if the tile is visible, false otherwise (or outside of the map).
+ */
+bool IsPosVisible(Vector2 pos);
+
+/**
+ * Frees the memory used by the playerView.
+ */
+void UnloadFieldOfView();
+
+#endif // FIELD_OF_VIEW_H
@@ -0,0 +1,115 @@
+/**********************************************************************************************
+ *
+ **   flow-field.h is responsible for defining a Dijkstra flow field over the walkable tiles,
+ **   seeded at a single goal, so any number of entities can follow it toward the goal.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include collision-grid.h, index-heap.h
+ *
+ **********************************************************************************************/
+
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include "collision-grid.h"
+#include "index-heap.h"
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Cost of the tiles that cannot reach the goal. */
+#define FLOW_UNREACHABLE -1
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Dijkstra map with the walking cost to the goal tile from the tiles around it.
+ *
+ * @param width         Width of the map in tiles
+ * @param height        Height of the map in tiles
+ * @param goalX         Horizontal (x) coordinate of the goal tile
+ * @param goalY         Vertical (y) coordinate of the goal tile
+ * @param costs         Array of width * height tiles with the cost to the goal (FLOW_UNREACHABLE if none)
+ * @param heap          Priority queue of tiles ordered by cost, used to build the field
+ * @param reached       Tiles given a cost by the last build, so only they are reset on the next one
+ * @param numOfReached  Number of tiles in the reached array
+ *
+ * ? @note Diagonal moves are only allowed if both orthogonal tiles are walkable (no corner cutting).
+ */
+typedef struct FlowField {
+    /** Width of the map in tiles. */
+    int width;
+    /** Height of the map in tiles. */
+    int height;
+    /** Goal tile of the field. */
+    int goalX;
+    int goalY;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major array with the walking cost from each tile to the goal.
+     */
+    int* costs;
+    /** Priority queue of tiles ordered by cost, kept to avoid allocations on every build. */
+    IndexHeap heap;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Tiles given a cost by the last build.
+     */
+    int* reached;
+    int numOfReached;
+} FlowField;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Flow field toward the player, shared by all the chasing enemies. */
+extern FlowField playerFlowField;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates the playerFlowField with the given dimensions and with no goal.
+ *
+ * ! @note Allocates memory for the arrays of the field. Must be freed with UnloadFlowField.
+ *
+ * @param width     Width of the map in tiles
+ * @param height    Height of the map in tiles
+ */
+void CreateFlowField(int width, int height);
+
+/**
+ * Rebuilds the playerFlowField toward the tile of the given point, up to a walking distance.
+ *
+ * @param goal      Point in world coordinates the entities will walk to
+ * @param radius    Max walking distance (tiles) from the goal of the tiles given a cost. Tiles
+ *                  further away are left as FLOW_UNREACHABLE.
+ *
+ * ? @note Does nothing if the goal is still in the same tile, so the field is only rebuilt
+ *         when the goal crosses a tile border.
+ * ? @note The cost of a build depends on the radius, not on the size of the map: only the tiles
+ *         reached by the last build are reset.
+ */
+void UpdateFlowField(Vector2 goal, int radius);
+
+/**
+ * Gets the next step toward the goal of the playerFlowField from a given point.
+ *
+ * @param pos       Point in world coordinates (usually the center of a hitbox)
+ * @param nextPos   Reference that receives the center of the next tile to walk to
+ * @return          True if there is a next step, false if the point is already in the goal tile
+ *                  or cannot reach it.
+ */
+bool GetFlowStep(Vector2 pos, Vector2* nextPos);
+
+/**
+ * Frees the memory used by the playerFlowField.
+ */
+void UnloadFlowField();
+
+#endif // FLOW_FIELD_H
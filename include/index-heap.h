@@ -0,0 +1,99 @@
+/**********************************************************************************************
+ *
+ **   index-heap.h is responsible for defining a binary min-heap of indices ordered by an
+ **   external array of keys, used as the priority queue of the path searches.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include raylib.h
+ *    @cite raylib
+ *
+ **********************************************************************************************/
+
+#ifndef INDEX_HEAP_H
+#define INDEX_HEAP_H
+
+#include "raylib.h"
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Binary min-heap of indices (tiles, graph nodes...) in the range [0, capacity).
+ *
+ * @param items     Array with the indices in the heap
+ * @param positions Array with the position of each index in items (-1 if not in the heap)
+ * @param keys      Array of capacity keys the indices are ordered by (owned by the caller)
+ * @param size      Number of indices in the heap
+ * @param capacity  Number of possible indices
+ *
+ * ? @note Lowering the key of an index already in the heap and pushing it again moves it up
+ *         instead of inserting a copy (decrease key).
+ */
+typedef struct IndexHeap {
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Indices in the heap, as a binary tree stored level by level.
+     */
+    int* items;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Position of each index in the items array (-1 if not in the heap).
+     */
+    int* positions;
+    /** Keys of the indices, the heap does not own this array. */
+    const int* keys;
+    /** Number of indices in the heap. */
+    int size;
+    /** Number of possible indices. */
+    int capacity;
+} IndexHeap;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates an empty heap for the indices in the range [0, capacity).
+ *
+ * ! @note Allocates memory for the arrays of the heap. Must be freed with UnloadIndexHeap.
+ *
+ * @param heap      Heap to initialize
+ * @param capacity  Number of possible indices
+ * @param keys      Array of capacity keys the indices will be ordered by
+ */
+void CreateIndexHeap(IndexHeap* heap, int capacity, const int* keys);
+
+/**
+ * Inserts an index in the heap, or moves it up if it is already in the heap and its key was lowered.
+ *
+ * @param heap  Heap to insert into
+ * @param item  Index in the range [0, capacity)
+ */
+void PushIndexHeap(IndexHeap* heap, int item);
+
+/**
+ * Removes the index with the lowest key from the heap.
+ *
+ * ! @attention The heap must not be empty.
+ *
+ * @param heap  Heap to remove from
+ * @return      Index with the lowest key.
+ */
+int PopIndexHeap(IndexHeap* heap);
+
+/**
+ * Removes all the indices from the heap.
+ *
+ * ? @note Only touches the indices still in the heap, not the whole capacity.
+ */
+void ClearIndexHeap(IndexHeap* heap);
+
+/**
+ * Frees the memory used by the heap.
+ */
+void UnloadIndexHeap(IndexHeap* heap);
+
+#endif // INDEX_HEAP_H
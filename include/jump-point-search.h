@@ -0,0 +1,93 @@
+/**********************************************************************************************
+ *
+ **   jump-point-search.h is responsible for defining the Jump Point Search (JPS) pathfinder
+ **   over the uniform-cost tiles of the collision grid.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include collision-grid.h, index-heap.h
+ *    @cite Online Graph Pruning for Pathfinding on Grid Maps (Harabor and Grastien)
+ *
+ **********************************************************************************************/
+
+#ifndef JUMP_POINT_SEARCH_H
+#define JUMP_POINT_SEARCH_H
+
+#include "collision-grid.h"
+#include "index-heap.h"
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Work arrays of the A* search over jump points, kept between searches so they never allocate.
+ *
+ * ! @attention A search can only run on one thread at a time, each thread needs its own.
+ *
+ * @param width     Width of the map in tiles
+ * @param height    Height of the map in tiles
+ * @param costs     Array of width * height tiles with the cost from the start of the last search
+ * @param scores    Array of width * height tiles with the cost plus the heuristic
+ * @param parents   Array of width * height tiles with the jump point each tile was reached from
+ * @param stamps    Array of width * height tiles, a tile was reached by the last search only if
+ *                  its stamp is equal to stamp
+ * @param stamp     Stamp of the last search
+ * @param heap      Priority queue of the jump points ordered by score
+ */
+typedef struct JumpPointSearch {
+    /** Width of the map in tiles. */
+    int width;
+    /** Height of the map in tiles. */
+    int height;
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    int* costs;
+    int* scores;
+    int* parents;
+    int* stamps;
+    /** Stamp of the last search. */
+    int stamp;
+    /** Priority queue of the jump points ordered by score. */
+    IndexHeap heap;
+} JumpPointSearch;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates the work arrays of a jump point search with the given dimensions.
+ *
+ * ! @note Allocates memory for the arrays of the search. Must be freed with UnloadJumpPointSearch.
+ *
+ * @param search    Search to create
+ * @param width     Width of the map in tiles
+ * @param height    Height of the map in tiles
+ */
+void CreateJumpPointSearch(JumpPointSearch* search, int width, int height);
+
+/**
+ * Finds the shortest path between two tiles, moving in 8 directions without cutting corners.
+ *
+ * @param search        Search whose work arrays are used
+ * @param startTile     Index of the start tile (y * width + x)
+ * @param goalTile      Index of the goal tile (y * width + x)
+ * @param waypoints     Array that receives the jump points of the path after the start, in order
+ * @param maxWaypoints  Size of the waypoints array
+ * @param numOfExpanded Reference that receives the number of jump points expanded by the search
+ * @return              Number of waypoints written, or -1 if there is no path.
+ *
+ * ? @note Consecutive waypoints are always in a straight or diagonal line of walkable tiles.
+ * ? @note Paths with more than maxWaypoints jump points are cut, only the first ones are written.
+ */
+int FindJumpPointPath(JumpPointSearch* search, int startTile, int goalTile, int waypoints[], int maxWaypoints, int* numOfExpanded);
+
+/**
+ * Frees the memory used by a jump point search.
+ *
+ * @param search    Search to unload
+ */
+void UnloadJumpPointSearch(JumpPointSearch* search);
+
+#endif // JUMP_POINT_SEARCH_H
@@ -0,0 +1,71 @@
+/**********************************************************************************************
+ *
+ **   kinematics.h is responsible for integrating the movement of many entities at once, stored
+ **   as packed arrays so it can be vectorised.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ **********************************************************************************************/
+
+#ifndef KINEMATICS_H
+#define KINEMATICS_H
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Max number of movers in a KinematicsBatch. Must be a multiple of the SIMD width (8). */
+#define KINEMATICS_BATCH_CAPACITY 64
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Packed arrays (structure of arrays) with the movement of a batch of entities.
+ *
+ * ? @note Movers whose isMoving is 0 are masked out, their direction and position are kept.
+ */
+typedef struct KinematicsBatch {
+    /** X coordinate of the position of each mover. */
+    float posX[KINEMATICS_BATCH_CAPACITY];
+    /** Y coordinate of the position of each mover. */
+    float posY[KINEMATICS_BATCH_CAPACITY];
+    /** X coordinate of the direction (or velocity once normalised) of each mover. */
+    float dirX[KINEMATICS_BATCH_CAPACITY];
+    /** Y coordinate of the direction (or velocity once normalised) of each mover. */
+    float dirY[KINEMATICS_BATCH_CAPACITY];
+    /** Speed of each mover. */
+    float speeds[KINEMATICS_BATCH_CAPACITY];
+    /** Duration of the simulation step of each mover in seconds. */
+    float deltaTimes[KINEMATICS_BATCH_CAPACITY];
+    /** 1 if the mover moves this step, 0 otherwise. */
+    int isMoving[KINEMATICS_BATCH_CAPACITY];
+    /** Number of movers in the batch. */
+    int size;
+} KinematicsBatch;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Turns the direction of each moving mover of the batch into its velocity: the direction
+ * normalised and scaled by the speed. Zero directions stay zero.
+ *
+ * @param batch The batch of movers.
+ *
+ * ? @note Same result as Vector2Scale(Vector2Normalize(direction), speed) for each mover.
+ * ? @note Runs 8 movers at a time on CPUs with AVX2, 4 at a time with SSE2 (picked at runtime).
+ */
+void NormalizeBatchVelocities(KinematicsBatch* batch);
+
+/**
+ * Moves each moving mover of the batch by its velocity over its own deltaTime.
+ *
+ * @param batch The batch of movers.
+ *
+ * ? @note Same result as Vector2Add(pos, Vector2Scale(direction, deltaTime)) for each mover.
+ * ? @note Runs 8 movers at a time on CPUs with AVX2, 4 at a time with SSE2 (picked at runtime).
+ */
+void IntegrateBatchPositions(KinematicsBatch* batch);
+
+#endif // KINEMATICS_H
@@ -0,0 +1,157 @@
+/**********************************************************************************************
+ *
+ **   path-cache.h is responsible for defining a cache of the paths found by the jump point
+ **   search and the followers that walk entities along them.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <pthread.h>, jump-point-search.h
+ *
+ **********************************************************************************************/
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include "jump-point-search.h"
+#include <pthread.h>
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Number of paths kept by the cache (direct mapped by start and goal tiles). */
+#define PATH_CACHE_SIZE 64
+
+/** Max number of waypoints of a cached path, longer paths are planned again from their last one. */
+#define MAX_PATH_WAYPOINTS 32
+
+/** Number of queries between two reports of the cache statistics in the debug log. */
+#define PATH_CACHE_LOG_INTERVAL 1024
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Path between two tiles found by the jump point search.
+ *
+ * @param startTile         Index of the start tile (-1 if this slot of the cache is empty)
+ * @param goalTile          Index of the goal tile
+ * @param numOfWaypoints    Number of waypoints, or -1 if there is no path
+ * @param waypoints         Jump points of the path after the start tile
+ */
+typedef struct CachedPath {
+    int startTile;
+    int goalTile;
+    int numOfWaypoints;
+    int waypoints[MAX_PATH_WAYPOINTS];
+} CachedPath;
+
+/**
+ * Walks an entity along a path, keeping its own copy of it so the cache is only requested
+ * when the path starts or is planned again.
+ *
+ * @param isActive      Indicates if the entity is following a path
+ * @param goalTile      Index of the goal tile
+ * @param waypoint      Index of the next waypoint to walk to
+ * @param gridRevision  Revision of the collisionGrid the path was found on
+ * @param path          Copy of the path being followed
+ *
+ * ? @note Paths cut at MAX_PATH_WAYPOINTS and paths found on an older collisionGrid are
+ *         requested again from the tile the entity is on at that moment.
+ */
+typedef struct PathFollower {
+    bool isActive;
+    int goalTile;
+    int waypoint;
+    unsigned int gridRevision;
+    CachedPath path;
+} PathFollower;
+
+/**
+ * Slot of the cache: a path and the follower that searched it.
+ *
+ * @param path      The path
+ * @param searcher  Follower whose request searched the path, hits are only counted for others
+ */
+typedef struct PathCacheSlot {
+    CachedPath path;
+    const PathFollower* searcher;
+} PathCacheSlot;
+
+/**
+ * Cache of paths keyed by their start and goal tiles, so entities going from the same tile
+ * to the same goal share a single search.
+ *
+ * @param mutex         Protects all the fields below, only held to read or write a slot
+ * @param slots         Slots of the cache
+ * @param gridRevision  Revision of the collisionGrid the paths were found on
+ * @param numOfQueries  Number of paths requested, without the ones a follower finds it searched itself
+ * @param numOfHits     Number of paths found in the cache that were searched for another follower
+ * @param numOfSearches Number of searches run for the misses
+ * @param numOfExpanded Number of jump points expanded by the searches of the misses
+ *
+ * ? @note All the paths are dropped when the collisionGrid changes.
+ * ? @note The searches of the misses run outside of the lock, with the work arrays of the thread
+ *         asking for the path, so the threads only wait for each other to copy a slot.
+ */
+typedef struct PathCache {
+    pthread_mutex_t mutex;
+    PathCacheSlot slots[PATH_CACHE_SIZE];
+    unsigned int gridRevision;
+    int numOfQueries;
+    int numOfHits;
+    int numOfSearches;
+    long numOfExpanded;
+} PathCache;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Paths shared by all the entities. */
+extern PathCache pathCache;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Drops all the paths of the cache and, if any path was requested, logs its statistics.
+ *
+ * ! @attention Not thread safe, only called while no path is being requested.
+ */
+void ClearPathCache();
+
+/**
+ * Gets the path between two tiles, searching it only if it is not in the cache.
+ *
+ * @param search    Search used on a miss, owned by the calling thread
+ * @param follower  Follower requesting the path
+ * @param startTile Index of the start tile (y * width + x)
+ * @param goalTile  Index of the goal tile (y * width + x)
+ * @param path      Reference that receives a copy of the path
+ */
+void GetCachedPath(
+    JumpPointSearch* search, const PathFollower* follower, int startTile, int goalTile, CachedPath* path);
+
+/**
+ * Starts following a path between two points.
+ *
+ * @param search    Search used if the path is not cached, owned by the calling thread
+ * @param follower  Follower to start
+ * @param from      Start point in world coordinates (usually the center of a hitbox)
+ * @param to        Goal point in world coordinates
+ */
+void StartPath(JumpPointSearch* search, PathFollower* follower, Vector2 from, Vector2 to);
+
+/**
+ * Gets the next point to walk to along the path of a follower.
+ *
+ * @param search    Search used if the path is planned again, owned by the calling thread
+ * @param follower  Follower walking the path
+ * @param pos       Current point in world coordinates (same point used to start the path)
+ * @param nextPos   Reference that receives the center of the next waypoint
+ * @return          True if there is a next waypoint, false if the point is already in the goal
+ *                  tile or there is no path.
+ */
+bool FollowPath(JumpPointSearch* search, PathFollower* follower, Vector2 pos, Vector2* nextPos);
+
+#endif // PATH_CACHE_H
@@ -0,0 +1,62 @@
+/**********************************************************************************************
+ *
+ **   path-planner.h is responsible for defining the work arrays of the path searches of each
+ **   thread of the worker pool, so the enemies plan their paths in parallel.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include jump-point-search.h, room-graph.h
+ *
+ **********************************************************************************************/
+
+#ifndef PATH_PLANNER_H
+#define PATH_PLANNER_H
+
+#include "jump-point-search.h"
+#include "room-graph.h"
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Work arrays of all the path searches run by a single thread.
+ *
+ * @param jumpPointSearch   Search of the paths back home (see path-cache.h)
+ * @param roomGraphSearch   Search of the chases across the rooms, with its own goal costs
+ */
+typedef struct PathPlanner {
+    JumpPointSearch jumpPointSearch;
+    RoomGraphSearch roomGraphSearch;
+} PathPlanner;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/**
+ * ! @attention This pointer will point to a location in heap that must be freed.
+ *
+ * One planner for each worker of the workerPool, indexed by the worker given to the jobs.
+ */
+extern PathPlanner* pathPlanners;
+
+/** Number of planners in the pathPlanners array. */
+extern int numOfPathPlanners;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Allocates a planner for each worker of the workerPool (its threads plus the main thread).
+ *
+ * ! @attention Needs the collisionGrid, the roomGraph and the workerPool to be created first.
+ * ! @note Allocates memory for the planners. Must be freed with UnloadPathPlanners.
+ */
+void CreatePathPlanners();
+
+/**
+ * Frees the memory used by the pathPlanners.
+ */
+void UnloadPathPlanners();
+
+#endif // PATH_PLANNER_H
@@ -47,11 +47,23 @@ void PlayerRender();
  */
 void PlayerUnload();
 
+/**
+ * Reads the input of the player that only lasts one frame (key presses).
+ *
+ * ! @attention Must be called once per rendered frame, before the simulation steps.
+ *
+ * ? @note The press is kept until the next PlayerUpdate, so it is neither lost when a frame
+ *         has no simulation step nor repeated when a frame has many.
+ */
+void PlayerInput();
+
 /**
  * Updates information required to move the player and handle their attacks.
+ *
+ * @param deltaTime Duration of the simulation step in seconds.
  * 
  * ? @note Calls PlayerMovement and PlayerAttack.
  */
-void PlayerUpdate();
+void PlayerUpdate(float deltaTime);
 
 #endif //PLAYER_H_
\ No newline at end of file
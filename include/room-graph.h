@@ -0,0 +1,222 @@
+/***********************************************************************************************
+ *
+ **   Provides definitions for the hierarchical path search (HPA*) over the rooms of the dungeon.
+ **   The entrances between rooms are the nodes of an abstract graph whose edges store the
+ **   walking cost inside each room, so long paths are planned on the graph and only refined
+ **   inside the current room.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include index-heap.h, room-regions.h
+ *    @cite Near Optimal Hierarchical Path-Finding (Botea, Müller and Schaeffer)
+ *
+ ***********************************************************************************************/
+
+#ifndef ROOM_GRAPH_H_
+#define ROOM_GRAPH_H_
+
+#include "index-heap.h"
+#include "room-regions.h"
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Cost of the tiles and nodes that were not reached by a search. */
+#define ROOM_PATH_UNREACHABLE -1
+
+/** Number of goals whose costs are kept by each RoomGraphSearch. */
+#define ROOM_GOAL_CACHE_SIZE 4
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Node of the abstract graph, one tile at each side of an entrance between two rooms.
+ *
+ * @param tile          Index of the tile of the node (y * width + x).
+ * @param region        Region (room) of the tile.
+ * @param partner       Node at the other side of the entrance.
+ * @param firstEdge     Index of the first edge of the node in the edges array.
+ * @param numOfEdges    Number of edges of the node.
+ * @param firstTileCost Index in nodeTileCosts of the walking cost from the node to the first tile
+ *                      of its region, followed by the costs to the rest of the region's tiles.
+ */
+typedef struct RoomGraphNode {
+    int tile;
+    int region;
+    int partner;
+    int firstEdge;
+    int numOfEdges;
+    int firstTileCost;
+} RoomGraphNode;
+
+/**
+ * Edge of the abstract graph.
+ *
+ * @param node  Index of the node at the end of the edge.
+ * @param cost  Walking cost between the nodes (STRAIGHT_STEP_COST and DIAGONAL_STEP_COST units).
+ */
+typedef struct RoomGraphEdge {
+    int node;
+    int cost;
+} RoomGraphEdge;
+
+/**
+ * Abstract graph of the entrances between rooms, plus the walking cost from each entrance to
+ * every tile of its room.
+ *
+ * @param nodes             Array of numOfNodes nodes, grouped by region.
+ * @param numOfNodes        Number of nodes.
+ * @param edges             Array of numOfEdges edges, grouped by their start node.
+ * @param numOfEdges        Number of edges.
+ * @param regionFirstNode   Array of numOfRegions + 1 indices, the nodes of region r are in the
+ *                          range [regionFirstNode[r], regionFirstNode[r + 1]).
+ * @param regionTiles       Array with the walkable tiles of every region, grouped by region.
+ * @param regionFirstTile   Array of numOfRegions + 1 indices, the tiles of region r are in the
+ *                          range [regionFirstTile[r], regionFirstTile[r + 1]) of regionTiles.
+ * @param tileSlots         Array of width * height tiles with the index of each tile among the
+ *                          tiles of its region (-1 for the tiles outside of every region).
+ * @param maxRegionSize     Number of tiles of the biggest region.
+ * @param nodeTileCosts     Walking cost from each node to each tile of its region
+ *                          (ROOM_PATH_UNREACHABLE if none), see RoomGraphNode.
+ *
+ * ? @note The costs of a tile are read at nodeTileCosts[node.firstTileCost + tileSlots[tile]].
+ */
+typedef struct RoomGraph {
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    RoomGraphNode* nodes;
+    int numOfNodes;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    RoomGraphEdge* edges;
+    int numOfEdges;
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    int* regionFirstNode;
+    int* regionTiles;
+    int* regionFirstTile;
+    int* tileSlots;
+    int maxRegionSize;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    int* nodeTileCosts;
+} RoomGraph;
+
+/**
+ * Walking costs to a goal tile, shared by all the paths planned toward it.
+ *
+ * @param goalTile  Index of the goal tile (-1 if this slot of the cache is empty).
+ * @param tileCosts Array of maxRegionSize tiles with the cost from each tile of the goal region
+ *                  to the goal, in the order of regionTiles.
+ * @param nodeCosts Array of numOfNodes nodes with the cost from each node to the goal over the graph.
+ */
+typedef struct RoomGoal {
+    int goalTile;
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    int* tileCosts;
+    int* nodeCosts;
+} RoomGoal;
+
+/**
+ * Work arrays of the searches on the room graph plus the costs of the last goals searched.
+ *
+ * ! @attention A search can only run on one thread at a time, each thread needs its own.
+ *
+ * @param tileCosts     Work array of width * height tiles with the costs of the last search
+ *                      inside a room.
+ * @param tileStamps    Work array of width * height tiles, a tile was reached by the last search
+ *                      inside a room only if its stamp is equal to stamp.
+ * @param stamp         Stamp of the last search inside a room.
+ * @param tileHeap      Priority queue of the searches inside a room.
+ * @param nodeCosts     Work array of numOfNodes nodes with the costs of the graph search.
+ * @param nodeHeap      Priority queue of the graph search.
+ * @param goals         Costs of the last ROOM_GOAL_CACHE_SIZE goals.
+ * @param nextGoal      Slot of goals replaced by the next goal that is not in the cache.
+ *
+ * ? @note The work arrays are kept between searches so a path query never allocates memory.
+ */
+typedef struct RoomGraphSearch {
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    int* tileCosts;
+    int* tileStamps;
+    int stamp;
+    IndexHeap tileHeap;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    int* nodeCosts;
+    IndexHeap nodeHeap;
+    RoomGoal goals[ROOM_GOAL_CACHE_SIZE];
+    int nextGoal;
+} RoomGraphSearch;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Abstract graph of the entrances between the rooms of the dungeon. */
+extern RoomGraph roomGraph;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Finds the entrances between the regions of roomRegions and precomputes the walking cost
+ * from every entrance to every tile of its room.
+ *
+ * ! @attention Needs BuildRoomRegions to be called first.
+ * ! @note Allocates memory for the arrays of roomGraph. Must be freed with UnloadRoomGraph.
+ *
+ * ? @note Neighbouring tiles of different rooms along the same border are merged into a single
+ *         entrance, placed at the middle of the border.
+ */
+void BuildRoomGraph();
+
+/**
+ * Allocates the work arrays of a search on the roomGraph.
+ *
+ * ! @attention Needs BuildRoomGraph to be called first.
+ * ! @note Allocates memory for the arrays of the search. Must be freed with UnloadRoomGraphSearch.
+ *
+ * @param search    Search to create.
+ */
+void CreateRoomGraphSearch(RoomGraphSearch* search);
+
+/**
+ * Gets the first step of the shortest path between two points over the room graph.
+ *
+ * @param search    Search whose work arrays and goal costs are used.
+ * @param from      Start point in world coordinates (usually the center of a hitbox).
+ * @param to        Goal point in world coordinates.
+ * @param nextPos   Reference that receives the center of the next tile to walk to.
+ * @returns         True if there is a next step, false if the start is already in the goal tile,
+ *                  either point is outside of every room or there is no path.
+ *
+ * ? @note The costs to a goal are searched once (inside its room, then over the graph) and kept
+ *         by the search, so every path toward the same goal only reads them. A step then costs
+ *         a few lookups in the precomputed costs of the entrances of the start room.
+ */
+bool GetRoomPathStep(RoomGraphSearch* search, Vector2 from, Vector2 to, Vector2* nextPos);
+
+/**
+ * Frees the memory used by a search on the roomGraph.
+ *
+ * @param search    Search to unload.
+ */
+void UnloadRoomGraphSearch(RoomGraphSearch* search);
+
+/**
+ * Frees the memory used by roomGraph.
+ */
+void UnloadRoomGraph();
+
+#endif // ROOM_GRAPH_H_
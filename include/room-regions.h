@@ -0,0 +1,122 @@
+/***********************************************************************************************
+ *
+ **   Provides definitions for the regions of the dungeon, which split the walkable tiles of the
+ **   map between its rooms, and for the potentially visible set (PVS) between the regions.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include collision-grid.h, field-of-view.h, spawner.h
+ *
+ ***********************************************************************************************/
+
+#ifndef ROOM_REGIONS_H_
+#define ROOM_REGIONS_H_
+
+#include "collision-grid.h"
+#include "field-of-view.h"
+#include "spawner.h"
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Region index of the tiles that do not belong to any room (solid or unreachable tiles). */
+#define NO_ROOM_REGION -1
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Represents the regions of the map covered by each room and which regions can see each other.
+ *
+ * @param width         Width of the map in tiles.
+ * @param height        Height of the map in tiles.
+ * @param tileRegions   Array of width * height tiles with the region index of each tile.
+ * @param numOfRegions  Number of regions (one for each room in the rooms list).
+ * @param visibleBits   Bit table of numOfRegions * numOfRegions bits. The bit of the pair
+ *                      (a, b) is set if any tile of region a can see any tile of region b.
+ *
+ * ? @note Tiles are accessed through the formula: tileRegions[y * width + x].
+ */
+typedef struct RoomRegions {
+    /** Width of the map in tiles. */
+    int width;
+    /** Height of the map in tiles. */
+    int height;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Row-major array with the region index of each tile (NO_ROOM_REGION if none).
+     */
+    int* tileRegions;
+    /** Number of regions in the map. */
+    int numOfRegions;
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     *
+     * Bit table with the visibility between every pair of regions (NULL until it is built).
+     */
+    unsigned char* visibleBits;
+} RoomRegions;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Regions of the rooms of the dungeon. */
+extern RoomRegions roomRegions;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Splits the walkable tiles of the map into one region per room.
+ *
+ * ! @attention Needs the rooms list and the collisionGrid to be loaded.
+ * ! @note Allocates memory for the tileRegions array of roomRegions.
+ *
+ * ? @note Each walkable tile belongs to the room whose spawn tiles are the closest by walking
+ *         distance (breadth first search from all the spawn tiles at once), so it runs in
+ *         linear time on the number of tiles.
+ */
+void BuildRoomRegions();
+
+/**
+ * Precomputes which regions can see each other within a given radius.
+ *
+ * ! @attention Needs BuildRoomRegions to be called and the playerView to be created first.
+ * ! @note Allocates memory for the visibleBits array of roomRegions.
+ *
+ * @param radius    Radius (tiles) of the field of view the table is checked against.
+ *
+ * ? @note Runs the playerView shadowcast from every walkable tile, so a region pair is visible
+ *         whenever the playerView could reveal a tile of one region from a tile of the other.
+ *         The playerView is left computed from the last tile, which is still a valid view.
+ */
+void BuildRoomVisibility(int radius);
+
+/**
+ * Returns the region (room) of a point.
+ *
+ * @param pos   Point in world coordinates.
+ * @returns     The region index, or NO_ROOM_REGION if the point is outside of every region.
+ */
+int GetRegion(Vector2 pos);
+
+/**
+ * Checks if the regions of two points can see each other.
+ *
+ * @param from  First point in world coordinates.
+ * @param to    Second point in world coordinates.
+ * @returns     False only if no tile of one region can see a tile of the other region.
+ *
+ * ? @note Points in the same region, outside of every region, or checked before the table is
+ *         built are always visible.
+ */
+bool AreRegionsVisible(Vector2 from, Vector2 to);
+
+/**
+ * Frees the memory used by roomRegions.
+ */
+void UnloadRoomRegions();
+
+#endif // ROOM_REGIONS_H_
@@ -26,6 +26,11 @@
 #define SCREEN_HEIGHT 720
 #define FRAME_RATE    60
 
+/** Fixed duration (seconds) of a simulation step of the dungeon. */
+#define SIMULATION_STEP (1.0f / FRAME_RATE)
+/** Max number of simulation steps run in a single frame, so a long hitch cannot stall the game. */
+#define MAX_SIMULATION_STEPS 5
+
 //* ------------------------------------------
 //* ENUMERATIONS
 
@@ -62,6 +67,12 @@ extern GameScreen nextScreen;
 /** Closes the game if true. */
 extern bool isRunning;
 
+/**
+ * How far (0 to 1) the rendered frame is between the last two simulation steps.
+ * Used to interpolate the positions of the entities.
+ */
+extern float renderAlpha;
+
 /** The timer for player personal record as a string. */
 extern char* timerAsStr;
 
@@ -83,8 +94,12 @@ void MainMenuUnload();
 
 /** Starts and loads all dungeon screen resources. */
 void DungeonStartup();
-/** Updates dungeon screen state. */
+/** Updates dungeon screen state that changes once per frame (input, music and end of game). */
 void DungeonUpdate();
+/** Advances the dungeon simulation (player and enemies) by a fixed step of deltaTime seconds. */
+void DungeonStep(float deltaTime);
+/** Moves the camera to the interpolated position of the player. Called before rendering. */
+void DungeonCameraUpdate();
 /** Renders dungeon screen current state on the screen. */
 void DungeonRender();
 /** Unloads (frees memory of) all dungeon screen resources. */
@@ -18,11 +18,14 @@
 //* ------------------------------------------
 //* DEFINITIONS
 
-/** The number of possible positions for each room size. */
+/** The initial number of possible positions for each room size, the arrays grow when full. */
 #define LG_ROOM_POS 30
 #define MD_ROOM_POS 20
 #define SM_ROOM_POS 10
 
+/** Initial number of slots of the room registry, it doubles when half full. */
+#define ROOM_REGISTRY_INITIAL_CAPACITY 64
+
 /** The max number of enemies for each room size. */
 #define LG_ROOM_MAX_ENEMIES 8
 #define MD_ROOM_MAX_ENEMIES 4
@@ -52,7 +55,7 @@ typedef enum RoomType { SAFE = 0, HOSTILE } RoomType;
 //* STRUCTURES
 
 /**
- * Represents information to describe an array of Vector2 positions.
+ * Represents information to describe a growable array of Vector2 positions.
  *
  * @param position  Array of Vector2 positions.
  * @param currSize  Current size of the array.
@@ -92,22 +95,47 @@ struct RoomNode {
     RoomNode* next;
 };
 
+/**
+ * Hash map (open addressing with linear probing) from room numbers to the rooms of the list.
+ *
+ * @param capacity      Number of slots, always a power of two.
+ * @param size          Number of rooms registered.
+ * @param roomNumbers   Room number of each slot.
+ * @param slots         Room of each slot, NULL if the slot is empty.
+ */
+typedef struct RoomRegistry {
+    int capacity;
+    int size;
+    /**
+     * ! @attention These pointers will point to locations in heap that must be freed.
+     */
+    int* roomNumbers;
+    RoomNode** slots;
+} RoomRegistry;
+
 //* ------------------------------------------
 //* GLOBAL VARIABLES
 
 /** The list of all rooms in the dungeon. */
 extern RoomNode* rooms;
 
+/** The rooms of the list indexed by their room number. */
+extern RoomRegistry roomRegistry;
+
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
 /**
  * Adds a specified position to given positionArray.
+ *
+ * ! @note Reallocates the positions array, doubling its size, when it is full.
  */
 void AddPosition(PositionArray* positionArray, Vector2 position);
 
 /**
  * Adds a specified position to a positionArray that is in a given roomNumber.
+ *
+ * ? @note Returns if no room has the given roomNumber.
  */
 void AddPositionToRoom(int roomNumber, Vector2 position);
 
@@ -132,21 +160,35 @@ RoomNode* CreateRoomList(Vector2 initPos, int roomNumber, RoomSize roomSize);
  * @param roomSize      The room size to set.
  * @param roomType      The room type to set.
  *
- * ? @note Calls CreateRoomList to create the node.
+ * ? @note Calls CreateRoomList to create the node, starting the list if it is empty.
+ * ? @note The room is also registered in the roomRegistry.
  */
 void AddRoomNode(Vector2 position, int roomNumber, RoomSize roomSize);
 
+/**
+ * Finds the room with the given roomNumber in the roomRegistry.
+ *
+ * @param roomNumber    The room number to find.
+ * @returns             The room, or NULL if no room has the given roomNumber.
+ *
+ * ? @note Runs in constant time on average, no matter the number of rooms.
+ */
+RoomNode* FindRoom(int roomNumber);
+
 /**
  * Unallocates the entire list of rooms.
  *
  * ! @note Unallocates memory for the RoomNode.
  * ? @note Calls UnloadPositionArray to unallocate memory for each positionArray.
+ * ? @note Also clears the roomRegistry.
  */
 void UnloadRooms();
 
 /**
  * Checks if a room exists in memory with the given roomNumber.
  *
+ * ? @note Calls FindRoom.
+ *
  * @returns true if it exists, false otherwise.
  */
 bool CheckRoomExists(int roomNumber);
@@ -0,0 +1,120 @@
+/**********************************************************************************************
+ *
+ **   worker-pool.h is responsible for defining a pool of threads that run a job over a range
+ **   of items in parallel, split in chunks taken by whichever thread is free.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <pthread.h>, <stdbool.h>
+ *
+ **********************************************************************************************/
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Max number of threads created besides the main thread, which also runs the jobs. */
+#define WORKER_POOL_MAX_THREADS 15
+
+/** Number of items taken by a thread at a time. Smaller jobs are run on the main thread only. */
+#define WORKER_POOL_CHUNK_SIZE 64
+
+//* ------------------------------------------
+//* TYPES
+
+/**
+ * Job run by the worker pool over the items in [first, last).
+ *
+ * ! @attention Runs on several threads at the same time, it must only write to its own items.
+ *
+ * ? @note worker is the index of the thread running the chunk, in [0, GetNumOfWorkers()), 0
+ *         being the main thread. Data of its own (like work arrays) can be kept per worker.
+ */
+typedef void (*WorkerJob)(int first, int last, int worker, void* data);
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Threads waiting for jobs and the state of the job being run.
+ *
+ * @param threads       Threads of the pool
+ * @param numOfThreads  Number of threads created
+ * @param mutex         Protects all the fields below
+ * @param workReady     Signaled when a new job is posted (or the pool stops)
+ * @param workDone      Signaled when the last busy thread finishes its chunks
+ * @param job           Job being run
+ * @param data          Argument given to the job
+ * @param numOfItems    Number of items of the job
+ * @param nextItem      First item not taken by any thread yet
+ * @param numOfBusy     Number of threads running chunks of the job
+ * @param generation    Counter increased every time a job is posted
+ * @param isStopping    Tells the threads to exit
+ */
+typedef struct WorkerPool {
+    /**
+     * ! @attention This pointer will point to a location in heap that must be freed.
+     */
+    pthread_t* threads;
+    int numOfThreads;
+    pthread_mutex_t mutex;
+    pthread_cond_t workReady;
+    pthread_cond_t workDone;
+    WorkerJob job;
+    void* data;
+    int numOfItems;
+    int nextItem;
+    int numOfBusy;
+    unsigned int generation;
+    bool isStopping;
+} WorkerPool;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Pool of threads shared by the parallel updates of the game. */
+extern WorkerPool workerPool;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Starts the threads of the workerPool, one for each online core besides the one of the main
+ * thread, up to WORKER_POOL_MAX_THREADS.
+ *
+ * ! @note Allocates memory for the threads. Must be stopped with UnloadWorkerPool.
+ *
+ * ? @note If a thread cannot be created the pool keeps the ones already running, with no
+ *         threads (single core machines) the jobs just run on the main thread.
+ */
+void CreateWorkerPool();
+
+/**
+ * Runs a job over the items [0, numOfItems) on the workerPool and the main thread, returning
+ * once every item is done.
+ *
+ * @param job           Job to run on each chunk of items
+ * @param data          Argument given to every call of the job
+ * @param numOfItems    Number of items
+ *
+ * ? @note Jobs with up to WORKER_POOL_CHUNK_SIZE items run directly on the main thread.
+ */
+void RunWorkerPool(WorkerJob job, void* data, int numOfItems);
+
+/**
+ * Gets the number of workers that run the jobs: the threads of the workerPool plus the main thread.
+ */
+int GetNumOfWorkers();
+
+/**
+ * Stops and joins the threads of the workerPool and frees its memory.
+ */
+void UnloadWorkerPool();
+
+#endif // WORKER_POOL_H
@@ -42,6 +42,15 @@ static Rectangle* GetSpriteRectangles(int numOfFrames, int tileWidth, int tileHe
  */
 static int FindNumOfTiles(int tileWidth, TextureFile textureType);
 
+/**
+ * Advances the current frame of an animation from its timer and draws it.
+ *
+ * ? @note Shared by DrawAnimation and DrawAnimationState.
+ */
+static void DrawTimedFrame(
+    Texture2D texture, const Rectangle* frames, int numOfFrames, int fps, int* curFrame,
+    Timer* timer, Rectangle dest, int entityWidth, int entityHeight, float rotation);
+
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
@@ -61,23 +70,33 @@ Animation CreateAnimation(int fps, int tileWidth, int tileHeight, TextureFile te
     return animation;
 }
 
+AnimationDescriptor CreateAnimationDescriptor(int fps, int tileWidth, int tileHeight, TextureFile textureType) {
+    if(textureType < 0 || textureType > MAX_TEXTURES) return (AnimationDescriptor){};
+
+    int numOfTiles = FindNumOfTiles(tileWidth, textureType);
+
+    return (AnimationDescriptor){ .fps         = fps,
+                                  .numOfFrames = numOfTiles,
+                                  .frames      = GetSpriteRectangles(numOfTiles, tileWidth, tileHeight),
+                                  .texture     = textures[textureType] };
+}
+
 void DrawAnimation(Animation* animation, Rectangle dest, int entityWidth, int entityHeight, float rotation) {
     if(animation == NULL) return;
-    if(TimerDone(&animation->timer)) return;
 
-    // if there is a delay return
-    if(CheckIfDelayed(&animation->timer)) return;
+    DrawTimedFrame(
+        animation->texture, animation->frames, animation->numOfFrames, animation->fps,
+        &animation->curFrame, &animation->timer, dest, entityWidth, entityHeight, rotation);
+}
 
-    if(!isPaused) {
-        animation->curFrame =
-            (int) (GetElapsedTime(&animation->timer) * animation->fps) %
-            animation->numOfFrames;
-    }
-    Rectangle source = animation->frames[animation->curFrame];
+void DrawAnimationState(
+    const AnimationDescriptor* descriptor, AnimationState* state, Rectangle dest,
+    int entityWidth, int entityHeight, float rotation) {
+    if(descriptor == NULL || state == NULL) return;
 
-    source.width  = entityWidth;
-    source.height = entityHeight;
-    DrawTexturePro(animation->texture, source, dest, (Vector2){ 0, 0 }, rotation, WHITE);
+    DrawTimedFrame(
+        descriptor->texture, descriptor->frames, descriptor->numOfFrames, descriptor->fps,
+        &state->curFrame, &state->timer, dest, entityWidth, entityHeight, rotation);
 }
 
 void DrawAnimationFrame(
@@ -115,6 +134,14 @@ void AnimationUnload(Animation* animation) {
     animation         = NULL;
 }
 
+void UnloadAnimationDescriptor(AnimationDescriptor* descriptor) {
+    if(descriptor == NULL) return;
+
+    free(descriptor->frames);
+    descriptor->frames      = NULL;
+    descriptor->numOfFrames = 0;
+}
+
 static Rectangle* GetSpriteRectangles(int numOfFrames, int tileWidth, int tileHeight) {
     Rectangle* frames = (Rectangle*) malloc(sizeof(Rectangle) * numOfFrames);
 
@@ -134,4 +161,22 @@ static Rectangle* GetSpriteRectangles(int numOfFrames, int tileWidth, int tileHe
 static int FindNumOfTiles(int tileWidth, TextureFile textureType) {
     if(textureType < 0 || textureType > MAX_TEXTURES) return -1;
     return textures[textureType].width / tileWidth;
+}
+
+static void DrawTimedFrame(
+    Texture2D texture, const Rectangle* frames, int numOfFrames, int fps, int* curFrame,
+    Timer* timer, Rectangle dest, int entityWidth, int entityHeight, float rotation) {
+    if(TimerDone(timer)) return;
+
+    // if there is a delay return
+    if(CheckIfDelayed(timer)) return;
+
+    if(!isPaused) {
+        *curFrame = (int) (GetElapsedTime(timer) * fps) % numOfFrames;
+    }
+    Rectangle source = frames[*curFrame];
+
+    source.width  = entityWidth;
+    source.height = entityHeight;
+    DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, rotation, WHITE);
 }
\ No newline at end of file
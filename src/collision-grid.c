@@ -0,0 +1,361 @@
+/**********************************************************************************************
+ *
+ **   collision-grid.c is responsible for implementing the dense tile collision grid and its
+ **   constant time queries.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, <math.h>, collision-grid.h
+ *
+ **********************************************************************************************/
+
+#include "../include/collision-grid.h"
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Squared distance used for tiles that cannot reach any solid tile. */
+#define WALL_DISTANCE_INF 1e20f
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * One dimensional squared distance transform (lower envelope of parabolas).
+ *
+ * @param f         Input squared distances (0 for solid tiles, WALL_DISTANCE_INF otherwise)
+ * @param distances Output squared distances
+ * @param size      Number of elements of f and distances
+ * @param vertices  Work array of size elements (locations of the parabolas)
+ * @param bounds    Work array of size + 1 elements (boundaries between parabolas)
+ */
+static void DistanceTransform1D(float* f, float* distances, int size, int* vertices, float* bounds);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateCollisionGrid(int width, int height) {
+    collisionGrid.cells = (unsigned char*) calloc(width * height, sizeof(unsigned char));
+    if(collisionGrid.cells == NULL) {
+        TraceLog(LOG_FATAL, "COLLISION-GRID.C (CreateCollisionGrid, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    collisionGrid.width         = width;
+    collisionGrid.height        = height;
+    collisionGrid.recIndices    = NULL;
+    collisionGrid.recs          = NULL;
+    collisionGrid.numOfRecs     = 0;
+    collisionGrid.wallDistances = NULL;
+    collisionGrid.revision++;
+
+    TraceLog(LOG_INFO, "COLLISION-GRID.C (CreateCollisionGrid): Collision grid of %dx%d tiles created.", width, height);
+}
+
+void SetSolidTile(int x, int y) {
+    if(x < 0 || y < 0 || x >= collisionGrid.width || y >= collisionGrid.height) {
+        TraceLog(LOG_WARNING, "COLLISION-GRID.C (SetSolidTile, line: %d): Tile (%d, %d) outside of the grid.", __LINE__, x, y);
+        return;
+    }
+
+    collisionGrid.cells[y * collisionGrid.width + x] = 1;
+    collisionGrid.revision++;
+}
+
+bool IsSolid(int x, int y) {
+    if(x < 0 || y < 0 || x >= collisionGrid.width || y >= collisionGrid.height) return true;
+    return collisionGrid.cells[y * collisionGrid.width + x] != 0;
+}
+
+bool IsStepWalkable(int x, int y, int offsetX, int offsetY) {
+    if(IsSolid(x + offsetX, y + offsetY)) return false;
+    if(offsetX != 0 && offsetY != 0)
+        return !IsSolid(x + offsetX, y) && !IsSolid(x, y + offsetY);
+    return true;
+}
+
+bool IsRecSolid(Rectangle rec) {
+    // Tile range covered by the rectangle.
+    // ? NOTE: The far edge is exclusive, so a rectangle touching a tile border does not overlap it.
+    int minX = (int) floorf(rec.x / TILE_WIDTH);
+    int minY = (int) floorf(rec.y / TILE_HEIGHT);
+    int maxX = (int) ceilf((rec.x + rec.width) / TILE_WIDTH) - 1;
+    int maxY = (int) ceilf((rec.y + rec.height) / TILE_HEIGHT) - 1;
+
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            if(IsSolid(x, y)) return true;
+        }
+    }
+    return false;
+}
+
+void MergeSolidTiles() {
+    int numOfCells = collisionGrid.width * collisionGrid.height;
+
+    collisionGrid.recIndices = (int*) malloc(numOfCells * sizeof(int));
+    collisionGrid.recs       = (Rectangle*) malloc(numOfCells * sizeof(Rectangle));
+    if(collisionGrid.recIndices == NULL || collisionGrid.recs == NULL) {
+        TraceLog(LOG_FATAL, "COLLISION-GRID.C (MergeSolidTiles, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < numOfCells; i++) collisionGrid.recIndices[i] = -1;
+    collisionGrid.numOfRecs = 0;
+
+    int width = collisionGrid.width;
+    for(int y = 0; y < collisionGrid.height; y++) {
+        for(int x = 0; x < width; x++) {
+            int cell = y * width + x;
+            if(collisionGrid.cells[cell] == 0 || collisionGrid.recIndices[cell] != -1) continue;
+
+            // Grows the rectangle to the right while the tiles are solid and not merged yet.
+            int recWidth = 1;
+            while(x + recWidth < width && collisionGrid.cells[cell + recWidth] != 0 &&
+                  collisionGrid.recIndices[cell + recWidth] == -1)
+                recWidth++;
+
+            // Grows the rectangle down while the whole row below can be merged.
+            int recHeight = 1;
+            bool canGrow  = true;
+            while(canGrow && y + recHeight < collisionGrid.height) {
+                int rowStart = (y + recHeight) * width + x;
+                for(int i = 0; i < recWidth; i++) {
+                    if(collisionGrid.cells[rowStart + i] == 0 ||
+                       collisionGrid.recIndices[rowStart + i] != -1) {
+                        canGrow = false;
+                        break;
+                    }
+                }
+                if(canGrow) recHeight++;
+            }
+
+            int recIdx = collisionGrid.numOfRecs++;
+            collisionGrid.recs[recIdx] = (Rectangle){ .x      = x * TILE_WIDTH,
+                                                      .y      = y * TILE_HEIGHT,
+                                                      .width  = recWidth * TILE_WIDTH,
+                                                      .height = recHeight * TILE_HEIGHT };
+
+            for(int row = y; row < y + recHeight; row++) {
+                for(int col = x; col < x + recWidth; col++) {
+                    collisionGrid.recIndices[row * width + col] = recIdx;
+                }
+            }
+        }
+    }
+
+    TraceLog(LOG_INFO, "COLLISION-GRID.C (MergeSolidTiles): Solid tiles merged into %d collision rectangles.", collisionGrid.numOfRecs);
+}
+
+int GetSweptCollisionRecs(Rectangle hitbox, Vector2 displacement, Rectangle recs[], int maxRecs) {
+    if(collisionGrid.recIndices == NULL) return 0;
+
+    // Bounding box of the hitbox at the start and at the end of the movement.
+    float left   = hitbox.x + (displacement.x < 0 ? displacement.x : 0);
+    float top    = hitbox.y + (displacement.y < 0 ? displacement.y : 0);
+    float right  = hitbox.x + hitbox.width + (displacement.x > 0 ? displacement.x : 0);
+    float bottom = hitbox.y + hitbox.height + (displacement.y > 0 ? displacement.y : 0);
+
+    // Clamps the tile range to the grid, everything outside of it is out of the map.
+    int minX = Clamp(floorf(left / TILE_WIDTH), 0, collisionGrid.width - 1);
+    int minY = Clamp(floorf(top / TILE_HEIGHT), 0, collisionGrid.height - 1);
+    int maxX = Clamp(floorf(right / TILE_WIDTH), 0, collisionGrid.width - 1);
+    int maxY = Clamp(floorf(bottom / TILE_HEIGHT), 0, collisionGrid.height - 1);
+
+    // Indexes of the rectangles already listed. A merged rectangle covers many tiles.
+    int listedIndices[MAX_SWEPT_RECS];
+    int numOfRecs = 0;
+
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            int recIdx = collisionGrid.recIndices[y * collisionGrid.width + x];
+            if(recIdx == -1) continue;
+
+            bool isListed = false;
+            for(int i = 0; i < numOfRecs && !isListed; i++) {
+                isListed = listedIndices[i] == recIdx;
+            }
+            if(isListed) continue;
+
+            if(numOfRecs == maxRecs || numOfRecs == MAX_SWEPT_RECS) {
+                TraceLog(LOG_WARNING, "COLLISION-GRID.C (GetSweptCollisionRecs, line: %d): Sweep overlaps more than %d collision rectangles.", __LINE__, numOfRecs);
+                return numOfRecs;
+            }
+            listedIndices[numOfRecs] = recIdx;
+            recs[numOfRecs++]        = collisionGrid.recs[recIdx];
+        }
+    }
+    return numOfRecs;
+}
+
+void ComputeWallDistances() {
+    int width      = collisionGrid.width;
+    int height     = collisionGrid.height;
+    int numOfCells = width * height;
+    int maxSize    = width > height ? width : height;
+    if(numOfCells == 0) return;
+
+    collisionGrid.wallDistances = (float*) malloc(numOfCells * sizeof(float));
+
+    float* line      = (float*) malloc(maxSize * sizeof(float));
+    float* lineDists = (float*) malloc(maxSize * sizeof(float));
+    int* vertices    = (int*) malloc(maxSize * sizeof(int));
+    float* bounds    = (float*) malloc((maxSize + 1) * sizeof(float));
+
+    if(collisionGrid.wallDistances == NULL || line == NULL || lineDists == NULL ||
+       vertices == NULL || bounds == NULL) {
+        TraceLog(LOG_FATAL, "COLLISION-GRID.C (ComputeWallDistances, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    float* distances = collisionGrid.wallDistances;
+    for(int i = 0; i < numOfCells; i++) {
+        distances[i] = collisionGrid.cells[i] != 0 ? 0 : WALL_DISTANCE_INF;
+    }
+
+    // Squared distances along the columns, then along the rows (tile units).
+    for(int x = 0; x < width; x++) {
+        for(int y = 0; y < height; y++) line[y] = distances[y * width + x];
+        DistanceTransform1D(line, lineDists, height, vertices, bounds);
+        for(int y = 0; y < height; y++) distances[y * width + x] = lineDists[y];
+    }
+
+    for(int y = 0; y < height; y++) {
+        DistanceTransform1D(&distances[y * width], lineDists, width, vertices, bounds);
+        for(int x = 0; x < width; x++) {
+            // ? NOTE: Tiles are square, so tile units can be scaled by TILE_WIDTH only.
+            distances[y * width + x] = sqrtf(lineDists[x]) * TILE_WIDTH;
+        }
+    }
+
+    free(line);
+    free(lineDists);
+    free(vertices);
+    free(bounds);
+
+    TraceLog(LOG_INFO, "COLLISION-GRID.C (ComputeWallDistances): Wall distance field computed.");
+}
+
+float SampleWallDistance(Vector2 pos) {
+    if(collisionGrid.wallDistances == NULL) return 0;
+
+    // Position relative to the tile centers.
+    float gridX = pos.x / TILE_WIDTH - 0.5f;
+    float gridY = pos.y / TILE_HEIGHT - 0.5f;
+
+    int x0 = (int) floorf(gridX);
+    int y0 = (int) floorf(gridY);
+    float tx = gridX - x0;
+    float ty = gridY - y0;
+
+    // Clamps the four samples to the grid.
+    int x1 = Clamp(x0 + 1, 0, collisionGrid.width - 1);
+    int y1 = Clamp(y0 + 1, 0, collisionGrid.height - 1);
+    x0     = Clamp(x0, 0, collisionGrid.width - 1);
+    y0     = Clamp(y0, 0, collisionGrid.height - 1);
+
+    float* distances = collisionGrid.wallDistances;
+    int width        = collisionGrid.width;
+
+    float top    = Lerp(distances[y0 * width + x0], distances[y0 * width + x1], tx);
+    float bottom = Lerp(distances[y1 * width + x0], distances[y1 * width + x1], tx);
+    return Lerp(top, bottom, ty);
+}
+
+bool IsLineOfSightClear(Vector2 from, Vector2 to) {
+    int x    = (int) floorf(from.x / TILE_WIDTH);
+    int y    = (int) floorf(from.y / TILE_HEIGHT);
+    int endX = (int) floorf(to.x / TILE_WIDTH);
+    int endY = (int) floorf(to.y / TILE_HEIGHT);
+
+    if(IsSolid(x, y)) return false;
+
+    float dx  = to.x - from.x;
+    float dy  = to.y - from.y;
+    int stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    int stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+
+    // Time (0 to 1 along the segment) to cross a whole tile on each axis.
+    float deltaTimeX = stepX != 0 ? TILE_WIDTH / fabsf(dx) : INFINITY;
+    float deltaTimeY = stepY != 0 ? TILE_HEIGHT / fabsf(dy) : INFINITY;
+
+    // Time of the first crossing of a tile border on each axis.
+    float nextTimeX = INFINITY;
+    float nextTimeY = INFINITY;
+    if(stepX != 0) nextTimeX = ((x + (stepX > 0 ? 1 : 0)) * TILE_WIDTH - from.x) / dx;
+    if(stepY != 0) nextTimeY = ((y + (stepY > 0 ? 1 : 0)) * TILE_HEIGHT - from.y) / dy;
+
+    // Each step crosses one border, so the end tile is reached after this many steps.
+    int numOfSteps = abs(endX - x) + abs(endY - y);
+    for(int i = 0; i < numOfSteps; i++) {
+        if(nextTimeX < nextTimeY) {
+            x += stepX;
+            nextTimeX += deltaTimeX;
+        } else {
+            y += stepY;
+            nextTimeY += deltaTimeY;
+        }
+
+        if(IsSolid(x, y)) return false;
+    }
+    return true;
+}
+
+int GetLinesOfSight(Vector2 origin, const Vector2 targets[], bool isClear[], int size) {
+    // A solid origin blocks every segment, no need to walk them.
+    bool isOriginSolid = IsSolid((int) floorf(origin.x / TILE_WIDTH), (int) floorf(origin.y / TILE_HEIGHT));
+
+    int numOfClear = 0;
+    for(int i = 0; i < size; i++) {
+        isClear[i] = !isOriginSolid && IsLineOfSightClear(origin, targets[i]);
+        if(isClear[i]) numOfClear++;
+    }
+    return numOfClear;
+}
+
+static void DistanceTransform1D(float* f, float* distances, int size, int* vertices, float* bounds) {
+    int k       = 0;
+    vertices[0] = 0;
+    bounds[0]   = -INFINITY;
+    bounds[1]   = INFINITY;
+
+    // Builds the lower envelope of the parabolas rooted at each element.
+    for(int q = 1; q < size; q++) {
+        float s;
+        while(true) {
+            int v = vertices[k];
+            s     = ((f[q] + q * q) - (f[v] + v * v)) / (2.0f * q - 2.0f * v);
+            if(s > bounds[k]) break;
+            k--;
+        }
+
+        k++;
+        vertices[k]   = q;
+        bounds[k]     = s;
+        bounds[k + 1] = INFINITY;
+    }
+
+    // Reads the squared distance of each element from the envelope.
+    k = 0;
+    for(int q = 0; q < size; q++) {
+        while(bounds[k + 1] < q) k++;
+        float diff   = q - vertices[k];
+        distances[q] = diff * diff + f[vertices[k]];
+    }
+}
+
+void UnloadCollisionGrid() {
+    free(collisionGrid.cells);
+    free(collisionGrid.recIndices);
+    free(collisionGrid.recs);
+    free(collisionGrid.wallDistances);
+    collisionGrid.cells         = NULL;
+    collisionGrid.recIndices    = NULL;
+    collisionGrid.recs          = NULL;
+    collisionGrid.wallDistances = NULL;
+    collisionGrid.numOfRecs     = 0;
+    collisionGrid.width         = 0;
+    collisionGrid.height        = 0;
+
+    TraceLog(LOG_INFO, "COLLISION-GRID.C (UnloadCollisionGrid): Collision grid unloaded successfully.");
+}
@@ -6,7 +6,7 @@
  *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h>, collision.h, utils.h
+ *    @include <stdlib.h>, collision.h, utils.h, <emmintrin.h> (SSE2 builds only)
  *
  **********************************************************************************************/
 
@@ -14,16 +14,9 @@
 #include "../include/utils.h"
 #include <stdlib.h>
 
-//* ------------------------------------------
-//* FUNCTION PROTOTYPES
-
-/**
- * Swap the value of two nodes in the CollisionNode linked list.
- *
- * @param nodeA CollisionNode*
- * @param nodeB CollisionNode*
- */
-static void SwapCollisionNode(CollisionNode* nodeA, CollisionNode* nodeB);
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
@@ -62,8 +55,18 @@ RayCollision2D RayRectCollision(Ray2D ray, Rectangle hitbox) {
 
     // Sort the collision point in case they are in different quadrants
     // instead of the origin quadrant (0,0)
-    if(nearColTime.x > farColTime.x) SWAP(nearColTime.x, farColTime.x);
-    if(nearColTime.y > farColTime.y) SWAP(nearColTime.y, farColTime.y);
+    // ? NOTE: Swapped through a temporary, SWAP adds and subtracts the times, which rounds them
+    // ? and turns the infinite times of axis-parallel rays into NaN.
+    if(nearColTime.x > farColTime.x) {
+        float time    = nearColTime.x;
+        nearColTime.x = farColTime.x;
+        farColTime.x  = time;
+    }
+    if(nearColTime.y > farColTime.y) {
+        float time    = nearColTime.y;
+        nearColTime.y = farColTime.y;
+        farColTime.y  = time;
+    }
 
     // Checks for collision rules, if they are not met,
     // returns RayCollision2D structure with no hit
@@ -109,11 +112,10 @@ RayCollision2D RayRectCollision(Ray2D ray, Rectangle hitbox) {
     return collision;
 }
 
-RayCollision2D HitboxCollision(Rectangle hitboxIn, Vector2 direction, Rectangle hitboxTarget) {
+RayCollision2D HitboxCollision(
+    Rectangle hitboxIn, Vector2 direction, Rectangle hitboxTarget, float deltaTime) {
     // Initializes the collision structure with no collition
     RayCollision2D collision;
-    // Gets the delta time during the collision
-    float deltaTime = GetFrameTime();
 
     // Considers that initially the Rectangles are not steady and inside each
     // other and returns if the direction is zero
@@ -124,11 +126,7 @@ RayCollision2D HitboxCollision(Rectangle hitboxIn, Vector2 direction, Rectangle
 
     // Creates an expanded target rectangle based on the size of the hitboxIn
     // rectangle which is where the direction ray will collide.
-    Rectangle expandedTarget =
-        (Rectangle){ .x      = hitboxTarget.x - (hitboxIn.width / 2),
-                     .y      = hitboxTarget.y - (hitboxIn.height / 2),
-                     .width  = hitboxTarget.width + hitboxIn.width,
-                     .height = hitboxTarget.height + hitboxIn.height };
+    Rectangle expandedTarget = ExpandHitbox(hitboxIn, hitboxTarget);
 
     // Creates a Ray2D from the origin of the hitboxIn rectangle to the
     // direction vector, but modulated by deltaTime.
@@ -149,74 +147,134 @@ RayCollision2D HitboxCollision(Rectangle hitboxIn, Vector2 direction, Rectangle
     return collision;
 }
 
-CollisionNode* CreateCollisionList(int indexX, int indexY, float timeHit) {
-    CollisionNode* newList = (CollisionNode*) malloc(sizeof(CollisionNode));
-    if(newList == NULL) {
-        TraceLog(LOG_FATAL, "COLLISION.C (CreateCollisionList, line: %d): Memory allocation failure.", __LINE__);
+#if defined(__SSE2__)
+RayCollision2D RayRectBatchCollision(
+    Ray2D ray, const RectangleBatch* batch, int* hitIndex, RayCollision2D collisions[]) {
+    RayCollision2D earliest;
+    earliest.hit  = false;
+    int earliestIdx = -1;
+
+    const __m128 originX = _mm_set1_ps(ray.origin.x);
+    const __m128 originY = _mm_set1_ps(ray.origin.y);
+    const __m128 dirX    = _mm_set1_ps(ray.direction.x);
+    const __m128 dirY    = _mm_set1_ps(ray.direction.y);
+    const __m128 zero    = _mm_setzero_ps();
+
+    for(int base = 0; base < batch->size; base += 4) {
+        __m128 recX = _mm_loadu_ps(&batch->x[base]);
+        __m128 recY = _mm_loadu_ps(&batch->y[base]);
+        __m128 recW = _mm_loadu_ps(&batch->width[base]);
+        __m128 recH = _mm_loadu_ps(&batch->height[base]);
+
+        // Same near and far collision times as RayRectCollision, 4 rectangles at a time.
+        __m128 nearX = _mm_div_ps(_mm_sub_ps(recX, originX), dirX);
+        __m128 nearY = _mm_div_ps(_mm_sub_ps(recY, originY), dirY);
+        __m128 farX  = _mm_div_ps(_mm_sub_ps(_mm_add_ps(recX, recW), originX), dirX);
+        __m128 farY  = _mm_div_ps(_mm_sub_ps(_mm_add_ps(recY, recH), originY), dirY);
+
+        // Division of zero by zero (NaN) means no collision.
+        __m128 isNaN = _mm_or_ps(_mm_cmpunord_ps(nearX, nearY), _mm_cmpunord_ps(farX, farY));
+
+        // Sorts the near and far times of each axis.
+        __m128 minX = _mm_min_ps(nearX, farX);
+        __m128 maxX = _mm_max_ps(nearX, farX);
+        __m128 minY = _mm_min_ps(nearY, farY);
+        __m128 maxY = _mm_max_ps(nearY, farY);
+
+        __m128 timeHit = _mm_max_ps(minX, minY);
+        __m128 farTime = _mm_min_ps(maxX, maxY);
+
+        __m128 isMiss = _mm_or_ps(_mm_cmpgt_ps(minX, maxY), _mm_cmpgt_ps(minY, maxX));
+        isMiss        = _mm_or_ps(isMiss, _mm_cmplt_ps(farTime, zero));
+        isMiss        = _mm_or_ps(isMiss, isNaN);
+
+        int missMask  = _mm_movemask_ps(isMiss);
+        int xAxisMask = _mm_movemask_ps(_mm_cmpgt_ps(minX, minY));
+
+        float times[4];
+        _mm_storeu_ps(times, timeHit);
+
+        for(int lane = 0; lane < 4 && base + lane < batch->size; lane++) {
+            RayCollision2D collision;
+            collision.hit = !(missMask & (1 << lane));
+
+            if(collision.hit) {
+                collision.timeHit = times[lane];
+                collision.contactPoint =
+                    Vector2Add(ray.origin, Vector2Scale(ray.direction, collision.timeHit));
+
+                if(xAxisMask & (1 << lane))
+                    collision.normalVector = (Vector2){ ray.direction.x < 0 ? 1 : -1, 0 };
+                else
+                    collision.normalVector = (Vector2){ 0, ray.direction.y < 0 ? 1 : -1 };
+
+                if(collision.timeHit >= 0 && collision.timeHit <= 1 &&
+                   (!earliest.hit || collision.timeHit < earliest.timeHit)) {
+                    earliest    = collision;
+                    earliestIdx = base + lane;
+                }
+            }
+
+            if(collisions != NULL) collisions[base + lane] = collision;
+        }
     }
-    newList->collidedHitbox = (CollidedHitboxInfo){ (Vector2){ indexX, indexY }, timeHit };
-    newList->next = NULL;
 
-    return newList;
+    if(hitIndex != NULL) *hitIndex = earliestIdx;
+    return earliest;
 }
+#else
+RayCollision2D RayRectBatchCollision(
+    Ray2D ray, const RectangleBatch* batch, int* hitIndex, RayCollision2D collisions[]) {
+    RayCollision2D earliest;
+    earliest.hit  = false;
+    int earliestIdx = -1;
+
+    // Scalar fallback for builds without SSE2.
+    for(int i = 0; i < batch->size; i++) {
+        Rectangle rec = (Rectangle){ batch->x[i], batch->y[i], batch->width[i], batch->height[i] };
+        RayCollision2D collision = RayRectCollision(ray, rec);
+
+        if(collision.hit && collision.timeHit >= 0 && collision.timeHit <= 1 &&
+           (!earliest.hit || collision.timeHit < earliest.timeHit)) {
+            earliest    = collision;
+            earliestIdx = i;
+        }
 
-void AddCollisionNode(CollisionNode* head, int indexX, int indexY, float timeHit) {
-    CollisionNode* currentNode;
-    CollisionNode* newNode;
-
-    currentNode = head;
-
-    newNode = (CollisionNode*) malloc(sizeof(CollisionNode));
-    if(newNode == NULL) {
-        TraceLog(LOG_FATAL, "COLLISION.C (AddCollisionNode, line: %d): Memory allocation failure.", __LINE__);
+        if(collisions != NULL) collisions[i] = collision;
     }
 
-    newNode->collidedHitbox = (CollidedHitboxInfo){ (Vector2){ indexX, indexY }, timeHit };
-    newNode->next = NULL;
-
-    while(currentNode->next != NULL)
-        currentNode = currentNode->next;
-
-    currentNode->next = newNode;
+    if(hitIndex != NULL) *hitIndex = earliestIdx;
+    return earliest;
 }
+#endif
 
-void SortCollisionList(CollisionNode* head) {
-    if(head == NULL) return;
-
-    CollisionNode* currentNode;
-    CollisionNode* indexNode;
-
-    currentNode = head;
-    indexNode   = head->next;
-
-    while(currentNode->next != NULL) {
-        while(indexNode != NULL) {
-            if(currentNode->collidedHitbox.timeHit > indexNode->collidedHitbox.timeHit) {
-                SwapCollisionNode(currentNode, indexNode);
-            }
+bool AddRectangleToBatch(RectangleBatch* batch, Rectangle rec) {
+    if(batch->size == RECTANGLE_BATCH_CAPACITY) return false;
 
-            indexNode = indexNode->next;
-        }
+    batch->x[batch->size]      = rec.x;
+    batch->y[batch->size]      = rec.y;
+    batch->width[batch->size]  = rec.width;
+    batch->height[batch->size] = rec.height;
+    batch->size++;
+    return true;
+}
 
-        currentNode = currentNode->next;
-    }
+Rectangle ExpandHitbox(Rectangle hitboxIn, Rectangle hitboxTarget) {
+    return (Rectangle){ .x      = hitboxTarget.x - (hitboxIn.width / 2),
+                        .y      = hitboxTarget.y - (hitboxIn.height / 2),
+                        .width  = hitboxTarget.width + hitboxIn.width,
+                        .height = hitboxTarget.height + hitboxIn.height };
 }
 
-void FreeCollisionList(CollisionNode* head) {
-    if(head == NULL) return;
+void SortCollisionContacts(CollisionContact contacts[], int size) {
+    for(int i = 1; i < size; i++) {
+        CollisionContact contact = contacts[i];
 
-    CollisionNode* currentNode;
-    while(head != NULL) {
-        currentNode = head;
-        head        = head->next;
-        free(currentNode);
-        currentNode = NULL;
+        int j = i - 1;
+        while(j >= 0 && contacts[j].collision.timeHit > contact.collision.timeHit) {
+            contacts[j + 1] = contacts[j];
+            j--;
+        }
+        contacts[j + 1] = contact;
     }
 }
-
-static void SwapCollisionNode(CollisionNode* nodeA, CollisionNode* nodeB) {
-    CollidedHitboxInfo temp;
-    temp                  = nodeA->collidedHitbox;
-    nodeA->collidedHitbox = nodeB->collidedHitbox;
-    nodeB->collidedHitbox = temp;
-}
\ No newline at end of file
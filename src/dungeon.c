@@ -6,15 +6,25 @@
  *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
  *    @version 0.3
  *
- *    @include  <stdlib.h>, screen.h, tile.h, audio.h, enemy-list.h, player.h
+ *    @include  <stdlib.h>, screen.h, tile.h, audio.h, collision-grid.h, enemy-hash.h, player.h,
+ *              room-regions.h, room-graph.h, field-of-view.h, flow-field.h, path-cache.h,
+ *              path-planner.h, worker-pool.h
  *
  **********************************************************************************************/
 
 #include "../include/audio.h"
-#include "../include/enemy-list.h"
+#include "../include/collision-grid.h"
+#include "../include/enemy-hash.h"
+#include "../include/field-of-view.h"
+#include "../include/flow-field.h"
+#include "../include/path-cache.h"
+#include "../include/path-planner.h"
 #include "../include/player.h"
+#include "../include/room-graph.h"
+#include "../include/room-regions.h"
 #include "../include/screen.h"
 #include "../include/tile.h"
+#include "../include/worker-pool.h"
 #include <stdlib.h>
 
 //* ------------------------------------------
@@ -23,8 +33,8 @@
 /** Pointer for the framebuffer (white canvas) for displaying the map. */
 RenderTexture2D* worldCanvas;
 
-/** Linked list with indexes to all the possible collidable tiles. */
-CollisionNode* collidableTiles;
+/** Grid with the solidity of all the tiles of the world tilemap. */
+CollisionGrid collisionGrid;
 
 /** A reference to the game's tilemap (texture.h) */
 Texture2D* textures;
@@ -43,7 +53,7 @@ static void StartCamera();
 static void LoadTextures();
 
 /**
- * Allocates all the tiles into the world array and the collidableTiles list.
+ * Allocates all the tiles into the world array and the collisionGrid.
  */
 static void InitializeTiles();
 
@@ -65,8 +75,8 @@ void DungeonStartup() {
     // Allocate memory for the world framebuffer as RenderTexture2D
     worldCanvas = (RenderTexture2D*) malloc(sizeof(RenderTexture2D));
 
-    // Assign initial null value value for the collidableTiles list
-    collidableTiles = NULL;
+    // Assign initial empty value for the collisionGrid
+    collisionGrid = (CollisionGrid){ 0, 0, NULL };
 
     // Populating textures array with the texture images
     LoadTextures();
@@ -74,6 +84,16 @@ void DungeonStartup() {
     // Allocating tiles of type Tile into 2D array
     InitializeTiles();
 
+    // Splits the walkable tiles between the rooms, the room graph is built over these regions.
+    BuildRoomRegions();
+    BuildRoomGraph();
+    CreateFieldOfView(collisionGrid.width, collisionGrid.height);
+    BuildRoomVisibility(PLAYER_VIEW_RADIUS);
+    CreateFlowField(collisionGrid.width, collisionGrid.height);
+    ClearPathCache();
+    CreateWorkerPool();
+    CreatePathPlanners();
+
     StartCamera();
     SetupEnemies();
     PlayerStartup();
@@ -89,17 +109,26 @@ void DungeonStartup() {
 void DungeonUpdate() {
     // If player is dead, no need to check for anything
     // Instead, sends him to the final screen
-    if(!IsPlayerDead() && enemies != NULL) {
+    if(!IsPlayerDead() && !AreEnemiesDefeated()) {
         UpdateMusicStream(songs[DUNGEON_SONG]);
-        PlayerUpdate();
-        UpdateEnemies();
-
-        // Update camera to follow the player
-        camera.target = (Vector2){ (int) player.pos.x + 8, (int) player.pos.y + 16 };
+        PlayerInput();
     } else
         nextScreen = FINAL_SCREEN;
 }
 
+void DungeonStep(float deltaTime) {
+    if(IsPlayerDead() || AreEnemiesDefeated()) return;
+
+    PlayerUpdate(deltaTime);
+    UpdateEnemies(deltaTime);
+}
+
+void DungeonCameraUpdate() {
+    // Update camera to follow the player
+    Vector2 playerPos = Vector2Lerp(player.prevPos, player.pos, renderAlpha);
+    camera.target     = (Vector2){ (int) playerPos.x + 8, (int) playerPos.y + 16 };
+}
+
 void DungeonRender() {
     // If player is dead, no need to check for anything
     if(!IsPlayerDead()) {
@@ -123,11 +152,18 @@ void DungeonUnload() {
     // Unloads the enemy sprites and animations.
     UnloadEnemies();
 
-    // Unloads collidableTiles list
-    FreeCollisionList(collidableTiles);
-    collidableTiles = NULL;
-
-    TraceLog(LOG_INFO, "DUNGEON.C (DungeonUnload): Collidable tiles list unloaded successfully.");
+    // Unloads the rooms, their regions and the paths between them
+    UnloadRooms();
+    UnloadRoomGraph();
+    UnloadRoomRegions();
+    UnloadFieldOfView();
+    UnloadFlowField();
+    ClearPathCache();
+    UnloadPathPlanners();
+    UnloadWorkerPool();
+
+    // Unloads collisionGrid
+    UnloadCollisionGrid();
 
     // Unloads texture array
     for(int i = 0; i < MAX_TEXTURES; i++) {
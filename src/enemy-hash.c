@@ -0,0 +1,185 @@
+/***********************************************************************************************
+ *
+ **   Provides functionality for the spatial hash of the enemies.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <math.h>, <stdlib.h>, enemy-hash.h
+ *
+ ***********************************************************************************************/
+
+#include "../include/enemy-hash.h"
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Slots of the first enemy of each bucket of the enemy spatial hash (-1 if empty). */
+static int enemyBuckets[ENEMY_HASH_BUCKETS];
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Returns the bucket index of a tile cell.
+ *
+ * @param cellX Horizontal (x) tile coordinate.
+ * @param cellY Vertical (y) tile coordinate.
+ * @returns     Index of the bucket.
+ */
+static int GetBucketIndex(int cellX, int cellY);
+
+/**
+ * Returns the tile cell of a position in world coordinates.
+ *
+ * @param pos   Position in world coordinates.
+ * @param cellX Reference that will receive the horizontal (x) tile coordinate.
+ * @param cellY Reference that will receive the vertical (y) tile coordinate.
+ */
+static void GetEnemyCell(Vector2 pos, int* cellX, int* cellY);
+
+/**
+ * Makes sure a query has room for a number of slots, at least doubling its capacity.
+ *
+ * @param query     Query to grow.
+ * @param minSize   Number of slots needed.
+ */
+static void GrowEnemyQuery(EnemyQuery* query, int minSize);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void InsertEnemyInHash(int slot) {
+    GetEnemyCell(enemies.positions[slot], &enemies.cellsX[slot], &enemies.cellsY[slot]);
+
+    int bucket               = GetBucketIndex(enemies.cellsX[slot], enemies.cellsY[slot]);
+    enemies.nextInCell[slot] = enemyBuckets[bucket];
+    enemyBuckets[bucket]     = slot;
+}
+
+void RemoveEnemyFromHash(int slot) {
+    int* cursor = &enemyBuckets[GetBucketIndex(enemies.cellsX[slot], enemies.cellsY[slot])];
+    while(*cursor != -1) {
+        if(*cursor == slot) {
+            *cursor                  = enemies.nextInCell[slot];
+            enemies.nextInCell[slot] = -1;
+            return;
+        }
+        cursor = &enemies.nextInCell[*cursor];
+    }
+}
+
+void UpdateEnemyInHash(int slot) {
+    int cellX, cellY;
+    GetEnemyCell(enemies.positions[slot], &cellX, &cellY);
+    if(cellX == enemies.cellsX[slot] && cellY == enemies.cellsY[slot]) return;
+
+    RemoveEnemyFromHash(slot);
+    InsertEnemyInHash(slot);
+}
+
+void ClearEnemyHash() {
+    for(int i = 0; i < ENEMY_HASH_BUCKETS; i++) enemyBuckets[i] = -1;
+}
+
+int QueryEnemiesInRect(Rectangle rec, int results[], int maxResults) {
+    // The hitbox of an enemy is inside its sprite, so the cells to the left and above the
+    // rectangle might hold enemies that reach into it. One extra tile covers the hitbox
+    // being updated before the enemy moves.
+    int minX, minY, maxX, maxY;
+    GetEnemyCell(
+        (Vector2){ rec.x - ENEMY_MAX_WIDTH - TILE_WIDTH, rec.y - ENEMY_MAX_HEIGHT - TILE_HEIGHT },
+        &minX, &minY);
+    GetEnemyCell(
+        (Vector2){ rec.x + rec.width + TILE_WIDTH, rec.y + rec.height + TILE_HEIGHT }, &maxX, &maxY);
+
+    int numOfResults = 0;
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            int slot = enemyBuckets[GetBucketIndex(x, y)];
+            while(slot != -1) {
+                // Different cells can share a bucket, so only the enemies of this cell count.
+                if(enemies.cellsX[slot] == x && enemies.cellsY[slot] == y &&
+                   CheckCollisionRecs(rec, enemies.hitboxes[slot])) {
+                    if(numOfResults < maxResults) results[numOfResults] = slot;
+                    numOfResults++;
+                }
+                slot = enemies.nextInCell[slot];
+            }
+        }
+    }
+    return numOfResults;
+}
+
+int QueryEnemiesInRadius(Vector2 center, float radius, int results[], int maxResults) {
+    int minX, minY, maxX, maxY;
+    GetEnemyCell((Vector2){ center.x - radius, center.y - radius }, &minX, &minY);
+    GetEnemyCell((Vector2){ center.x + radius, center.y + radius }, &maxX, &maxY);
+
+    int numOfResults = 0;
+    for(int y = minY; y <= maxY; y++) {
+        for(int x = minX; x <= maxX; x++) {
+            int slot = enemyBuckets[GetBucketIndex(x, y)];
+            while(slot != -1) {
+                if(enemies.cellsX[slot] == x && enemies.cellsY[slot] == y &&
+                   Vector2Distance(center, enemies.positions[slot]) <= radius) {
+                    if(numOfResults < maxResults) results[numOfResults] = slot;
+                    numOfResults++;
+                }
+                slot = enemies.nextInCell[slot];
+            }
+        }
+    }
+    return numOfResults;
+}
+
+void CollectEnemiesInRect(Rectangle rec, EnemyQuery* query) {
+    if(query->capacity == 0) GrowEnemyQuery(query, ENEMY_QUERY_INITIAL_CAPACITY);
+
+    query->size = QueryEnemiesInRect(rec, query->slots, query->capacity);
+    if(query->size > query->capacity) {
+        // Rare, the query only runs again when more enemies were found than ever before.
+        GrowEnemyQuery(query, query->size);
+        query->size = QueryEnemiesInRect(rec, query->slots, query->capacity);
+    }
+}
+
+void CollectEnemiesInRadius(Vector2 center, float radius, EnemyQuery* query) {
+    if(query->capacity == 0) GrowEnemyQuery(query, ENEMY_QUERY_INITIAL_CAPACITY);
+
+    query->size = QueryEnemiesInRadius(center, radius, query->slots, query->capacity);
+    if(query->size > query->capacity) {
+        GrowEnemyQuery(query, query->size);
+        query->size = QueryEnemiesInRadius(center, radius, query->slots, query->capacity);
+    }
+}
+
+void UnloadEnemyQuery(EnemyQuery* query) {
+    free(query->slots);
+    query->slots    = NULL;
+    query->size     = 0;
+    query->capacity = 0;
+}
+
+static int GetBucketIndex(int cellX, int cellY) {
+    unsigned int hash = ((unsigned int) cellX * 73856093u) ^ ((unsigned int) cellY * 19349663u);
+    return hash & (ENEMY_HASH_BUCKETS - 1);
+}
+
+static void GetEnemyCell(Vector2 pos, int* cellX, int* cellY) {
+    *cellX = (int) floorf(pos.x / TILE_WIDTH);
+    *cellY = (int) floorf(pos.y / TILE_HEIGHT);
+}
+
+static void GrowEnemyQuery(EnemyQuery* query, int minSize) {
+    int capacity = query->capacity * 2;
+    if(capacity < minSize) capacity = minSize;
+
+    query->slots = (int*) realloc(query->slots, capacity * sizeof(int));
+    if(query->slots == NULL) {
+        TraceLog(LOG_FATAL, "ENEMY-HASH.C (GrowEnemyQuery, line: %d): Memory allocation failure.", __LINE__);
+    }
+    query->capacity = capacity;
+}
@@ -5,71 +5,110 @@
  *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h>, enemy-list.h, spawner.h
+ *    @include <stdlib.h>, <string.h>, enemy-list.h, enemy-hash.h, enemy-pool.h, field-of-view.h,
+ *             flow-field.h, kinematics.h, room-regions.h, spawner.h, worker-pool.h
  *
  ***********************************************************************************************/
 
 #include "../include/enemy-list.h"
+#include "../include/enemy-hash.h"
+#include "../include/enemy-pool.h"
+#include "../include/field-of-view.h"
+#include "../include/flow-field.h"
+#include "../include/kinematics.h"
+#include "../include/room-regions.h"
 #include "../include/spawner.h"
+#include "../include/worker-pool.h"
 #include <stdlib.h>
+#include <string.h>
 
 //* ------------------------------------------
 //* DEFINITIONS
 const Vector2 WAFFLES_POS = { 74, 10 };
 
+/**
+ * Walking distance (tiles) from the player covered by the flow field. Only the enemies that see
+ * the player follow it, twice their view radius leaves room for walking around obstacles.
+ */
+#define FLOW_FIELD_RADIUS (2 * PLAYER_VIEW_RADIUS)
+
 //* ------------------------------------------
 //* GLOBAL VARIABLES
 
-EnemyNode* enemies;
+EnemyPool enemies;
+
+/** Region of the room where DEMON_WAFFLES is spawned. */
+static int wafflesRegion;
+
+/** Enemies within AGRO_RANGE of the player, found on each update. */
+static EnemyQuery nearQuery;
 
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
 /**
- * Adds a specified number of enemies to the enemies list with a given positionArray at random positions.
+ * Adds a specified number of enemies to the pool with a given positionArray at random positions.
  *
  * @param numOfEnemies  Number of enemies to add.
  * @param positionArray The array object holding the positions and the number of positions.
  *
- * ! @note Calls CreateEnemyList and AddEnemyNode.
+ * ! @note Calls AddEnemy.
  * ? @note Calls EnemyStartup on each enemy (see enemy.c).
  * ? @note Uses LoadRandomSequence from raylib.
  */
 static void AddEnemies(int numOfEnemies, PositionArray positionArray);
 
 /**
- * Adds a specified enemy to the enemies list with a given pos.
+ * Adds a specified enemy to the pool with a given pos.
  *
  * @param pos   The position that the enemy should spawn.
  * @param type  Type of enemy.
  *
- * ! @note Calls AddEnemyNode.
+ * ! @note Calls AddEnemy.
  * ? @note the given position must be a valid position on the map (position is not checked internally).
  */
 static void AddParticularEnemy(Vector2 pos, EnemyType type);
 
 /**
- * Creates the enemies linked list and returns a reference to the first EnemyNode in the list.
+ * Adds an enemy at the end of the partition of its type, growing the pool if it is full.
  *
- * @param enemy The enemy to add as the first EnemyNode.
+ * @param enemy The enemy entity to add.
  * @param type  Type of enemy to add.
- * @returns     The reference to the first EnemyNode.
+ * @returns     The slot of the new enemy.
  *
- * ! @note Allocates memory for the first EnemyNode.
+ * ! @note Reallocates the arrays of the pool when it grows.
+ * ? @note Moves the first enemy of each following type to the end of its partition to make room.
+ * ? @note Calls AdjustEnemy on the new enemy.
  */
-static EnemyNode* CreateEnemyList(Entity enemy, EnemyType type);
+static int AddEnemy(Entity enemy, EnemyType type);
 
 /**
- * Creates an EnemyNode and adds it to the end of the enemies linked list.
+ * Removes the enemy in a slot by moving the last enemy of its type into it, then the last enemy
+ * of each following type into the slot freed before it.
  *
- * ! @attention Returns if there is a NULL head pointer.
+ * @param slot  The slot of the enemy to remove.
  *
- * @param enemy The enemy to add as an EnemyNode.
- * @param type  Type of enemy to add.
+ * ? @note Calls EnemyUnload on the removed enemy (see enemy.c).
+ * ? @note Only slots after the given one change, so the pool can be walked while removing.
+ */
+static void RemoveEnemy(int slot);
+
+/**
+ * Moves the enemy in a slot of the pool to a free slot, updating its handle and spatial hash entry.
  *
- * ! @note Allocates memory for an EnemyNode.
+ * @param from  Slot of the enemy to move.
+ * @param to    Free slot the enemy is moved to.
  */
-static void AddEnemyNode(Entity enemy, EnemyType type);
+static void MoveEnemySlot(int from, int to);
+
+/**
+ * Copies the position and hitbox of the entity of a slot to the arrays of the pool.
+ *
+ * ! @attention Only called on the main thread, the arrays are read by the parallel update.
+ *
+ * @param slot  Slot of the enemy.
+ */
+static void StoreEnemyBody(int slot);
 
 /**
  * Returns the number of enemies for a given roomSize.
@@ -89,108 +128,294 @@ static int GetNumOfEnemies(RoomSize roomSize);
 static EnemyType GetRandomEnemyType();
 
 /**
- * Adjusts the positions of all enemies to be clear from any obstacles.
+ * Adjusts the position of a new enemy to be clear from any obstacles and inserts it in the
+ * spatial hash.
+ *
+ * @param slot  Slot of the enemy to adjust.
+ */
+static void AdjustEnemy(int slot);
+
+/**
+ * Creates the enemies of a region of roomRegions, the first time the player reaches it.
+ *
+ * @param region    Region reached.
+ *
+ * ? @note Calls AddEnemies with the position array of the room of the region.
+ */
+static void SpawnRegionEnemies(int region);
+
+/**
+ * Counts the enemies spawned in a room when the player reaches it.
+ *
+ * @param room      The room.
+ * @param region    Region of the room.
+ * @returns         Number of enemies of the room (limited by its spawn positions), plus
+ *                  DEMON_WAFFLES if it is its room.
+ */
+static int GetNumOfRoomEnemies(RoomNode* room, int region);
+
+/**
+ * Counts the tiles of each region of roomRegions.
+ *
+ * @returns Array of numOfRegions + 1 sizes.
+ *
+ * ! @attention Allocates memory for the array, it must be freed.
+ */
+static int* GetRegionSizes();
+
+/**
+ * Returns the level of detail an enemy of the pool is simulated at, waking it up if the player
+ * reached its room, saw it or damaged it.
+ *
+ * @param slot      Slot of the enemy.
+ * @param health    Initial health points of the type of the enemy.
+ * @returns         An EnemyLod.
+ */
+static EnemyLod GetEnemyLod(int slot, int health);
+
+/**
+ * Job of the parallel phase of UpdateEnemies. Handles the attack and movement of the enemies
+ * in the slots [first, last), one partition of the same type at a time, in batches of up to
+ * KINEMATICS_BATCH_CAPACITY enemies.
+ *
+ * @param first     First slot to update.
+ * @param last      Slot after the last one to update.
+ * @param worker    Worker running the slots, its planner is used for the paths of the enemies.
+ * @param data      Unused, the step of each enemy is in enemies.stepTimes.
+ *
+ * ! @attention Runs on several threads, it must only write to the given slots.
  */
-static void AdjustEnemies();
+static void UpdateEnemiesRange(int first, int last, int worker, void* data);
 
 /**
- * Handles the movement of an enemy node in the list of enemies.
+ * Handles the attack and movement of a batch of enemies of the same type.
  *
- * ? @note Calls EnemyMovement on each enemy (see enemy.c).
+ * ? @note Calls HandleEnemiesAttack and EnemyMovement on each enemy (see enemy.c), then moves
+ *         the enemies steered with the kinematics of a KinematicsBatch, only the collisions
+ *         being checked one enemy at a time (same steps as MoveEntityTowardsPos).
+ * ? @note Only the enemies found by QueryEnemiesInRect around the enemy are used as
+ *         neighbours, both to block its movement and to separate overlapping enemies.
+ * ? @note The neighbours are read from the snapshot, as they may be moving on other threads.
  * 
- * @param currEnemy Currenty enemy node being checked.
+ * @param first     First slot of the batch.
+ * @param last      Slot after the last one of the batch, at most KINEMATICS_BATCH_CAPACITY after first.
+ * @param behaviour Behaviour of the type of the enemies.
+ * @param planner   Planner of the thread running the batch.
  */
-static void MoveEnemies(EnemyNode* currEnemy);
+static void MoveEnemies(int first, int last, const EnemyBehaviour* behaviour, PathPlanner* planner);
 
 /**
- * Handles enemy attack of an enemy node in the list of enemies.
+ * Lists the enemies around an enemy of the pool that can block it or overlap it.
+ *
+ * @param slot          Slot of the enemy.
+ * @param neighbours    Array of MAX_ENEMY_NEIGHBOURS that will receive the neighbours, from the snapshot.
+ * @returns             Number of neighbours found.
+ */
+static int GetEnemyNeighbours(int slot, Entity* neighbours[]);
+
+/**
+ * Handles the attack of an enemy of the pool.
  *
  * ? @note Calls EnemyAttack on each enemy (see enemy.c).
  * 
- * @param currEnemy Currenty enemy node being checked.
+ * @param slot      Slot of the enemy being checked.
+ * @param behaviour Behaviour of the type of the enemy.
  */
-static void HandleEnemiesAttack(EnemyNode* currEnemy);
+static void HandleEnemiesAttack(int slot, const EnemyBehaviour* behaviour);
 
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
 void SetupEnemies() {
-    RoomNode* cursor = rooms;
-    while(cursor != NULL) {
-        if(cursor->roomNumber != 0) {
-            int numOfEnemies = GetNumOfEnemies(cursor->roomSize);
-            AddEnemies(numOfEnemies, cursor->positionArray);
+    LoadEnemyAnimations();
+    ResizeEnemyPool(ENEMY_POOL_INITIAL_CAPACITY);
+    ClearEnemyHash();
+    for(int type = 0; type <= MAX_ENEMY_TYPES; type++) enemies.typeStarts[type] = 0;
+
+    // One extra region so the array is never empty.
+    enemies.reachedRegions = (bool*) calloc(roomRegions.numOfRegions + 1, sizeof(bool));
+    if(enemies.reachedRegions == NULL) {
+        TraceLog(LOG_FATAL, "ENEMY-LIST.C (SetupEnemies, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    Vector2 wafflesCenter = { (WAFFLES_POS.x + 0.5f) * TILE_WIDTH, (WAFFLES_POS.y + 0.5f) * TILE_HEIGHT };
+    wafflesRegion         = GetRegion(wafflesCenter);
+    if(wafflesRegion == NO_ROOM_REGION) AddParticularEnemy(WAFFLES_POS, DEMON_WAFFLES);
+
+    // The rooms are the regions of roomRegions, in the same order as the rooms list.
+    int* regionSizes            = GetRegionSizes();
+    enemies.numOfPendingEnemies = 0;
+    int region = 0;
+    for(RoomNode* cursor = rooms; cursor != NULL; cursor = cursor->next, region++) {
+        if(region >= roomRegions.numOfRegions) {
+            if(cursor->roomNumber != 0) AddEnemies(GetNumOfEnemies(cursor->roomSize), cursor->positionArray);
+            continue;
+        }
+
+        enemies.numOfPendingEnemies += GetNumOfRoomEnemies(cursor, region);
+
+        // Regions without tiles can never be reached, their rooms are spawned right away.
+        if(regionSizes[region] == 0) {
+            enemies.reachedRegions[region] = true;
+            SpawnRegionEnemies(region);
         }
-        cursor = cursor->next;
     }
-    AddParticularEnemy(WAFFLES_POS, DEMON_WAFFLES);
-    AdjustEnemies();
-    UnloadRooms();
-    TraceLog(LOG_INFO, "ENEMY-LIST.C (SetupEnemies): Enemies set successfully.");
+    free(regionSizes);
+
+    TraceLog(LOG_INFO, "ENEMY-LIST.C (SetupEnemies): %d enemies set successfully, %d waiting for the player.", enemies.size, enemies.numOfPendingEnemies);
 }
 
-void UpdateEnemies() {
-    EnemyNode* currEnemy = enemies;
+bool AreEnemiesDefeated() {
+    return enemies.size == 0 && enemies.numOfPendingEnemies == 0;
+}
+
+void UpdateEnemies(float deltaTime) {
+    // Dead enemies are removed first, so the slots do not move during the parallel phase.
+    int slot = 0;
+    while(slot < enemies.size) {
+        if(enemies.entities[slot].health <= 0) {
+            RemoveEnemy(slot);
+        } else {
+            slot++;
+        }
+    }
 
-    CleanUpEnemies();
+    // Checked before the slots are used for anything else in this update.
+    if(enemies.numOfUpdates % ENEMY_SORT_INTERVAL == 0) SortEnemies();
 
-    while(currEnemy != NULL) {
-        UpdateEntityHitbox(&currEnemy->enemy);
-        HandleEnemiesAttack(currEnemy);
-        MoveEnemies(currEnemy);
+    // Only the enemies around the player need to check if they can see or attack it.
+    CollectEnemiesInRadius(player.pos, AGRO_RANGE, &nearQuery);
 
-        currEnemy = currEnemy->next;
+    Vector2 playerCenter = { player.pos.x + ENTITY_TILE_WIDTH / 2,
+                             player.pos.y + ENTITY_TILE_HEIGHT / 2 };
+
+    // Same for the flow field the chasing enemies follow, seeded at the feet of the player.
+    UpdateFlowField((Vector2){ player.hitbox.x + player.hitbox.width / 2,
+                               player.hitbox.y + player.hitbox.height / 2 },
+                    FLOW_FIELD_RADIUS);
+
+    bool isViewUpdated = false;
+    for(int i = 0; i < nearQuery.size; i++) {
+        int slot            = nearQuery.slots[i];
+        Vector2 enemyCenter = GetEnemyCenter(&enemies.entities[slot], enemies.types[slot]);
+
+        enemies.isPlayerNear[slot] = true;
+
+        // Enemies in rooms that cannot see the room of the player are rejected with one bit.
+        if(!AreRegionsVisible(enemyCenter, playerCenter)) {
+            enemies.isPlayerSeen[slot] = false;
+            continue;
+        }
+
+        // One field of view from the player is shared by all the enemies. It is only recomputed
+        // when an enemy needs it and the player moved to another tile.
+        if(!isViewUpdated) {
+            UpdateFieldOfView(playerCenter, PLAYER_VIEW_RADIUS);
+            isViewUpdated = true;
+        }
+        enemies.isPlayerSeen[slot] = IsPosVisible(enemyCenter);
     }
-}
 
-void RenderEnemies() {
-    EnemyNode* currEnemy = enemies;
-    while(currEnemy != NULL) {
-        EnemyRender(&currEnemy->enemy, currEnemy->type);
-        currEnemy = currEnemy->next;
+    // The rooms the player walks into stay reached, waking up their enemies.
+    int playerRegion = GetRegion(playerCenter);
+    if(playerRegion != NO_ROOM_REGION && !enemies.reachedRegions[playerRegion]) {
+        enemies.reachedRegions[playerRegion] = true;
+        SpawnRegionEnemies(playerRegion);
     }
-}
 
-void CleanUpEnemies() {
-    EnemyNode* cursor = enemies;
-    EnemyNode* prev   = NULL;
-    while(cursor != NULL) {
-        if(cursor->enemy.health <= 0) {
-            if(prev == NULL) {
-                enemies = cursor->next;
-                EnemyUnload(&cursor->enemy);
-                free(cursor);
-                cursor = enemies;
-            } else {
-                EnemyUnload(&cursor->enemy);
-                prev->next = cursor->next;
-                free(cursor);
-                cursor = prev->next;
+    enemies.numOfUpdates++;
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        int health = GetEnemyBehaviour(type)->archetype->health;
+
+        for(int slot = enemies.typeStarts[type]; slot < enemies.typeStarts[type + 1]; slot++) {
+            Entity* enemy           = &enemies.entities[slot];
+            enemies.stepTimes[slot] = 0.0f;
+
+            switch(GetEnemyLod(slot, health)) {
+                case ENEMY_LOD_FULL:
+                    enemies.stepTimes[slot]    = enemies.pendingTimes[slot] + deltaTime;
+                    enemies.pendingTimes[slot] = 0.0f;
+                    break;
+                case ENEMY_LOD_REDUCED:
+                    // The slot staggers the enemies, so each update only simulates a part of them.
+                    enemies.pendingTimes[slot] += deltaTime;
+                    if((enemies.numOfUpdates + slot) % ENEMY_REDUCED_RATE_INTERVAL == 0) {
+                        enemies.stepTimes[slot]    = enemies.pendingTimes[slot];
+                        enemies.pendingTimes[slot] = 0.0f;
+                    }
+                    break;
+                case ENEMY_LOD_ASLEEP: break;
             }
-        } else {
-            prev   = cursor;
-            cursor = cursor->next;
+
+            enemy->prevPos = enemy->pos;
+            if(enemies.stepTimes[slot] > 0.0f) {
+                UpdateEntityHitbox(enemy);
+                StoreEnemyBody(slot);
+            }
+        }
+    }
+
+    // Parallel phase, every enemy reads the world frozen in the snapshot and writes its own slot.
+    memcpy(enemies.snapshot, enemies.entities, enemies.size * sizeof(Entity));
+    RunWorkerPool(UpdateEnemiesRange, NULL, enemies.size);
+
+    // Serial phase, applies the damage to the player and moves the enemies in the spatial hash.
+    for(int slot = 0; slot < enemies.size; slot++) {
+        if(enemies.isHittingPlayer[slot]) CommitEnemyAttack(&enemies.entities[slot]);
+        if(enemies.stepTimes[slot] > 0.0f) {
+            StoreEnemyBody(slot);
+            UpdateEnemyInHash(slot);
         }
+
+        enemies.isPlayerNear[slot]    = false;
+        enemies.isPlayerSeen[slot]    = false;
+        enemies.isHittingPlayer[slot] = false;
     }
 }
 
-void UnloadEnemies() {
-    if(enemies == NULL) {
-        TraceLog(LOG_WARNING, "ENEMY-LIST.C (UnloadEnemies, line: %d): Enemies list is empty or could not be found.", __LINE__);
+void RenderEnemies() {
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        const EnemyBehaviour* behaviour = GetEnemyBehaviour(type);
+
+        for(int slot = enemies.typeStarts[type]; slot < enemies.typeStarts[type + 1]; slot++) {
+            EnemyRender(&enemies.entities[slot], behaviour, &enemies.animations[slot]);
+        }
     }
+}
 
-    while(enemies != NULL) {
-        EnemyNode* temp = enemies;
-        enemies         = enemies->next;
-        EnemyUnload(&temp->enemy);
-        free(temp);
-        temp = NULL;
+void UnloadEnemies() {
+    if(enemies.size == 0) {
+        TraceLog(LOG_WARNING, "ENEMY-LIST.C (UnloadEnemies, line: %d): Enemies pool is empty.", __LINE__);
     }
-    TraceLog(LOG_INFO, "ENEMY-LIST.C (UnloadEnemies): Enemies list unloaded successfully.");
+
+    for(int slot = 0; slot < enemies.size; slot++) EnemyUnload(&enemies.entities[slot]);
+
+    UnloadEnemyPool();
+
+    UnloadEnemyQuery(&nearQuery);
+    ClearEnemyHash();
+    UnloadEnemyAnimations();
+    TraceLog(LOG_INFO, "ENEMY-LIST.C (UnloadEnemies): Enemies pool unloaded successfully.");
+}
+
+EnemyHandle GetEnemyHandle(int slot) {
+    int id = enemies.ids[slot];
+    return (EnemyHandle){ id, enemies.idGenerations[id] };
+}
+
+int GetEnemySlot(EnemyHandle handle) {
+    if(handle.id < 0 || handle.id >= enemies.capacity) return -1;
+    if(enemies.idGenerations[handle.id] != handle.generation) return -1;
+
+    return enemies.idSlots[handle.id];
 }
 
 static void AddEnemies(int numOfEnemies, PositionArray positionArray) {
-    int* randNums = LoadRandomSequence(numOfEnemies, 0, positionArray.size - 1);
+    // Only the filled positions can be picked, the array may have room for more.
+    if(numOfEnemies > positionArray.currSize) numOfEnemies = positionArray.currSize;
+    if(numOfEnemies <= 0) return;
+
+    int* randNums = LoadRandomSequence(numOfEnemies, 0, positionArray.currSize - 1);
     Vector2* positions = positionArray.positions;
 
     for(int i = 0; i < numOfEnemies; i++) {
@@ -201,11 +426,7 @@ static void AddEnemies(int numOfEnemies, PositionArray positionArray) {
         Entity enemy   = EnemyStartup(
             (Vector2){ (float) position.x * TILE_WIDTH, (float) position.y * TILE_HEIGHT }, type);
 
-        if(enemies == NULL) {
-            enemies = CreateEnemyList(enemy, type);
-        } else {
-            AddEnemyNode(enemy, type);
-        }
+        AddEnemy(enemy, type);
     }
     UnloadRandomSequence(randNums);
 }
@@ -213,36 +434,81 @@ static void AddEnemies(int numOfEnemies, PositionArray positionArray) {
 static void AddParticularEnemy(Vector2 pos, EnemyType type) {
     Entity enemy =
         EnemyStartup((Vector2){ (float) pos.x * TILE_WIDTH, (float) pos.y * TILE_HEIGHT }, type);
-    AddEnemyNode(enemy, type);
+    AddEnemy(enemy, type);
 }
 
-static EnemyNode* CreateEnemyList(Entity enemy, EnemyType type) {
-    EnemyNode* enemyNode = (EnemyNode*) malloc(sizeof(EnemyNode));
-    if(enemyNode == NULL) {
-        TraceLog(LOG_FATAL, "ENEMY-LIST.C (CreateEnemyList, line: %d): Memory allocation failure.", __LINE__);
+static int AddEnemy(Entity enemy, EnemyType type) {
+    if(enemies.size == enemies.capacity) {
+        ResizeEnemyPool(enemies.capacity > 0 ? 2 * enemies.capacity : ENEMY_POOL_INITIAL_CAPACITY);
     }
 
-    enemyNode->enemy         = enemy;
-    enemyNode->type          = type;
-    enemyNode->lastPlayerPos = enemy.pos;
-    enemyNode->hasAttacked   = false;
-    enemyNode->next          = NULL;
-    return enemyNode;
+    // The first enemy of each following type moves to the end of its partition, so the free
+    // slot travels back from the end of the pool to the end of the partition of the new enemy.
+    int slot = enemies.size;
+    for(int next = MAX_ENEMY_TYPES - 1; next > (int) type; next--) {
+        int first = enemies.typeStarts[next];
+        if(first != slot) MoveEnemySlot(first, slot);
+        slot = first;
+    }
+    for(int next = type + 1; next <= MAX_ENEMY_TYPES; next++) enemies.typeStarts[next]++;
+    enemies.size++;
+
+    int id = enemies.freeIds[--enemies.numOfFreeIds];
+
+    enemies.entities[slot]            = enemy;
+    enemies.types[slot]               = type;
+    enemies.lastPlayerPositions[slot] = enemy.pos;
+    enemies.spawnPositions[slot]      = enemy.pos;
+    enemies.homePaths[slot]           = (PathFollower){ 0 };
+    StartEnemyAnimations(&enemies.animations[slot]);
+    enemies.hasAttacked[slot]         = false;
+    enemies.isPlayerNear[slot]        = false;
+    enemies.isPlayerSeen[slot]        = false;
+    enemies.isHittingPlayer[slot]     = false;
+    enemies.isAwake[slot]             = false;
+    enemies.pendingTimes[slot]        = 0.0f;
+    enemies.stepTimes[slot]           = 0.0f;
+    enemies.cellsX[slot]              = 0;
+    enemies.cellsY[slot]              = 0;
+    enemies.nextInCell[slot]          = -1;
+    enemies.ids[slot]                 = id;
+    enemies.idSlots[id]               = slot;
+
+    AdjustEnemy(slot);
+    return slot;
 }
 
-static void AddEnemyNode(Entity enemy, EnemyType type) {
-    if(enemies == NULL) return;
+static void RemoveEnemy(int slot) {
+    EnemyType type = enemies.types[slot];
+    int id         = enemies.ids[slot];
 
-    EnemyNode* enemyNode = CreateEnemyList(enemy, type);
-    if(enemyNode == NULL) {
-        TraceLog(LOG_FATAL, "ENEMY-LIST.C (AddEnemyNode, line: %d): Memory allocation failure.", __LINE__);
-    }
+    RemoveEnemyFromHash(slot);
+    EnemyUnload(&enemies.entities[slot]);
+
+    // The id is freed and its generation increased, so the handles to it become stale.
+    enemies.idSlots[id] = -1;
+    enemies.idGenerations[id]++;
+    enemies.freeIds[enemies.numOfFreeIds++] = id;
 
-    EnemyNode* cursor = enemies;
-    while(cursor->next != NULL) {
-        cursor = cursor->next;
+    // The free slot travels forward to the end of the pool, one partition at a time.
+    for(int next = type; next < MAX_ENEMY_TYPES; next++) {
+        int last = enemies.typeStarts[next + 1] - 1;
+        if(last != slot) MoveEnemySlot(last, slot);
+        slot = last;
     }
-    cursor->next = enemyNode;
+    for(int next = type + 1; next <= MAX_ENEMY_TYPES; next++) enemies.typeStarts[next]--;
+    enemies.size--;
+}
+
+static void MoveEnemySlot(int from, int to) {
+    RemoveEnemyFromHash(from);
+    CopyEnemySlot(from, to);
+    InsertEnemyInHash(to);
+}
+
+static void StoreEnemyBody(int slot) {
+    enemies.positions[slot] = enemies.entities[slot].pos;
+    enemies.hitboxes[slot]  = enemies.entities[slot].hitbox;
 }
 
 static int GetNumOfEnemies(RoomSize roomSize) {
@@ -268,25 +534,175 @@ static EnemyType GetRandomEnemyType() {
     return type;
 }
 
-static void AdjustEnemies() {
-    EnemyNode* cursor = enemies;
-    while(cursor != NULL) {
-        Vector2 diff   = cursor->enemy.pos;
-        float hitbox_X = cursor->enemy.hitbox.x;
-        float hitbox_Y = cursor->enemy.hitbox.y;
+static void AdjustEnemy(int slot) {
+    Entity* enemy  = &enemies.entities[slot];
+    Vector2 diff   = enemy->pos;
+    float hitbox_X = enemy->hitbox.x;
+    float hitbox_Y = enemy->hitbox.y;
+
+    diff.x = floorf(diff.x - hitbox_X);
+    diff.y = floorf(diff.y - hitbox_Y);
+
+    enemy->pos                        = Vector2Add(enemy->pos, diff);
+    enemy->prevPos                    = enemy->pos;
+    enemies.lastPlayerPositions[slot] = enemy->pos;
+    enemies.spawnPositions[slot]      = enemy->pos;
+
+    // Enemies are only hashed after their positions are adjusted.
+    StoreEnemyBody(slot);
+    InsertEnemyInHash(slot);
+}
+
+static void SpawnRegionEnemies(int region) {
+    RoomNode* room = rooms;
+    for(int i = 0; i < region && room != NULL; i++) room = room->next;
+    if(room == NULL || GetNumOfRoomEnemies(room, region) == 0) return;
+
+    int oldSize = enemies.size;
+    if(room->roomNumber != 0) AddEnemies(GetNumOfEnemies(room->roomSize), room->positionArray);
+    if(region == wafflesRegion) AddParticularEnemy(WAFFLES_POS, DEMON_WAFFLES);
+
+    enemies.numOfPendingEnemies -= enemies.size - oldSize;
+    TraceLog(LOG_INFO, "ENEMY-LIST.C (SpawnRegionEnemies): %d enemies spawned in room %d.", enemies.size - oldSize, room->roomNumber);
+}
+
+static int GetNumOfRoomEnemies(RoomNode* room, int region) {
+    int numOfEnemies = 0;
+    if(room->roomNumber != 0) {
+        numOfEnemies = GetNumOfEnemies(room->roomSize);
+        if(numOfEnemies > room->positionArray.currSize) numOfEnemies = room->positionArray.currSize;
+    }
+    if(region == wafflesRegion) numOfEnemies++;
+
+    return numOfEnemies;
+}
+
+static int* GetRegionSizes() {
+    int numOfTiles   = roomRegions.width * roomRegions.height;
+    int* regionSizes = (int*) calloc(roomRegions.numOfRegions + 1, sizeof(int));
+    if(regionSizes == NULL) {
+        TraceLog(LOG_FATAL, "ENEMY-LIST.C (GetRegionSizes, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int tile = 0; tile < numOfTiles; tile++) {
+        if(roomRegions.tileRegions[tile] != NO_ROOM_REGION) regionSizes[roomRegions.tileRegions[tile]]++;
+    }
+    return regionSizes;
+}
+
+static EnemyLod GetEnemyLod(int slot, int health) {
+    Vector2 pos = enemies.positions[slot];
 
-        diff.x = floorf(diff.x - hitbox_X);
-        diff.y = floorf(diff.y - hitbox_Y);
+    if(!enemies.isAwake[slot]) {
+        int region         = GetRegion(pos);
+        bool isRoomReached = region == NO_ROOM_REGION || enemies.reachedRegions[region];
+        bool isDamaged     = enemies.entities[slot].health < health;
+        if(!isRoomReached && !isDamaged && !enemies.isPlayerSeen[slot]) return ENEMY_LOD_ASLEEP;
 
-        cursor->enemy.pos = Vector2Add(cursor->enemy.pos, diff);
-        cursor            = cursor->next;
+        enemies.isAwake[slot] = true;
     }
+
+    if(Vector2Distance(pos, player.pos) <= ENEMY_FULL_RATE_RANGE) return ENEMY_LOD_FULL;
+    return ENEMY_LOD_REDUCED;
 }
 
-static void MoveEnemies(EnemyNode* currEnemy) {
-    EnemyMovement(&currEnemy->enemy, &(currEnemy->lastPlayerPos), currEnemy->type);
+static void UpdateEnemiesRange(int first, int last, int worker, void* data) {
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        int firstOfType = enemies.typeStarts[type] > first ? enemies.typeStarts[type] : first;
+        int lastOfType  = enemies.typeStarts[type + 1] < last ? enemies.typeStarts[type + 1] : last;
+        if(firstOfType >= lastOfType) continue;
+
+        const EnemyBehaviour* behaviour = GetEnemyBehaviour(type);
+        for(int slot = firstOfType; slot < lastOfType; slot += KINEMATICS_BATCH_CAPACITY) {
+            int lastOfBatch = slot + KINEMATICS_BATCH_CAPACITY;
+            MoveEnemies(slot, lastOfBatch < lastOfType ? lastOfBatch : lastOfType, behaviour, &pathPlanners[worker]);
+        }
+    }
+}
+
+static void MoveEnemies(int first, int last, const EnemyBehaviour* behaviour, PathPlanner* planner) {
+    KinematicsBatch batch;
+    int slots[KINEMATICS_BATCH_CAPACITY];
+    Entity* neighbours[KINEMATICS_BATCH_CAPACITY][MAX_ENEMY_NEIGHBOURS];
+    int numOfNeighbours[KINEMATICS_BATCH_CAPACITY];
+
+    // Steers every enemy of the batch, before any of them moves.
+    batch.size = 0;
+    for(int slot = first; slot < last; slot++) {
+        if(enemies.stepTimes[slot] <= 0.0f) continue;
+
+        Entity* enemy = &enemies.entities[slot];
+        int lane      = batch.size++;
+
+        slots[lane]           = slot;
+        numOfNeighbours[lane] = GetEnemyNeighbours(slot, neighbours[lane]);
+
+        HandleEnemiesAttack(slot, behaviour);
+        batch.isMoving[lane] = EnemyMovement(
+            enemy, &enemies.lastPlayerPositions[slot], enemies.spawnPositions[slot],
+            &enemies.homePaths[slot], behaviour->type, enemies.isPlayerSeen[slot], planner);
+
+        batch.dirX[lane]       = enemy->direction.x;
+        batch.dirY[lane]       = enemy->direction.y;
+        batch.speeds[lane]     = enemy->speed;
+        batch.deltaTimes[lane] = enemies.stepTimes[slot];
+    }
+
+    //! NOTE: Same as MoveEntityTowardsPos, deltaTime is only added after checking collisions.
+    NormalizeBatchVelocities(&batch);
+
+    for(int lane = 0; lane < batch.size; lane++) {
+        Entity* enemy = &enemies.entities[slots[lane]];
+
+        if(batch.isMoving[lane]) {
+            enemy->direction = (Vector2){ batch.dirX[lane], batch.dirY[lane] };
+            CollideEntity(
+                enemy, &enemies.lastPlayerPositions[slots[lane]], neighbours[lane],
+                numOfNeighbours[lane], batch.deltaTimes[lane]);
+        }
+
+        batch.posX[lane] = enemy->pos.x;
+        batch.posY[lane] = enemy->pos.y;
+        batch.dirX[lane] = enemy->direction.x;
+        batch.dirY[lane] = enemy->direction.y;
+    }
+
+    IntegrateBatchPositions(&batch);
+
+    for(int lane = 0; lane < batch.size; lane++) {
+        Entity* enemy = &enemies.entities[slots[lane]];
+        enemy->pos    = (Vector2){ batch.posX[lane], batch.posY[lane] };
+
+        UpdateEntityHitbox(enemy);
+        SeparateEntity(enemy, neighbours[lane], numOfNeighbours[lane]);
+    }
+}
+
+static int GetEnemyNeighbours(int slot, Entity* neighbours[]) {
+    Rectangle hitbox = enemies.hitboxes[slot];
+
+    // Neighbours are searched one tile around the hitbox, enemies never move that far in a frame.
+    Rectangle searchArea = (Rectangle){ .x      = hitbox.x - TILE_WIDTH,
+                                        .y      = hitbox.y - TILE_HEIGHT,
+                                        .width  = hitbox.width + 2 * TILE_WIDTH,
+                                        .height = hitbox.height + 2 * TILE_HEIGHT };
+
+    // One extra slot because the enemy itself is also found by the query. Separation only
+    // needs the first few neighbours, so the rest of the enemies found are left out.
+    int nearSlots[MAX_ENEMY_NEIGHBOURS + 1];
+    int numOfNearSlots =
+        QueryEnemiesInRect(searchArea, nearSlots, MAX_ENEMY_NEIGHBOURS + 1);
+    if(numOfNearSlots > MAX_ENEMY_NEIGHBOURS + 1) numOfNearSlots = MAX_ENEMY_NEIGHBOURS + 1;
+
+    int numOfNeighbours = 0;
+    for(int i = 0; i < numOfNearSlots && numOfNeighbours < MAX_ENEMY_NEIGHBOURS; i++) {
+        if(nearSlots[i] != slot) neighbours[numOfNeighbours++] = &enemies.snapshot[nearSlots[i]];
+    }
+    return numOfNeighbours;
 }
 
-static void HandleEnemiesAttack(EnemyNode* currEnemy) {
-    EnemyAttack(&currEnemy->enemy, currEnemy->type, &currEnemy->hasAttacked);
+static void HandleEnemiesAttack(int slot, const EnemyBehaviour* behaviour) {
+    EnemyAttack(
+        &enemies.entities[slot], behaviour, &enemies.animations[slot],
+        &enemies.hasAttacked[slot], &enemies.isHittingPlayer[slot], enemies.isPlayerNear[slot]);
 }
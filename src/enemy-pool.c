@@ -0,0 +1,212 @@
+/***********************************************************************************************
+ *
+ **   Provides functionality for the storage of the enemy pool.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, enemy-pool.h, enemy-hash.h
+ *
+ ***********************************************************************************************/
+
+#include "../include/enemy-pool.h"
+#include "../include/enemy-hash.h"
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Compares two slots of the pool by their enemies.sortKeys (qsort comparator).
+ */
+static int CompareEnemySlots(const void* a, const void* b);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void ResizeEnemyPool(int capacity) {
+    int oldCapacity = enemies.capacity;
+
+    enemies.entities            = (Entity*) realloc(enemies.entities, capacity * sizeof(Entity));
+    enemies.positions           = (Vector2*) realloc(enemies.positions, capacity * sizeof(Vector2));
+    enemies.hitboxes            = (Rectangle*) realloc(enemies.hitboxes, capacity * sizeof(Rectangle));
+    enemies.types               = (EnemyType*) realloc(enemies.types, capacity * sizeof(EnemyType));
+    enemies.lastPlayerPositions = (Vector2*) realloc(enemies.lastPlayerPositions, capacity * sizeof(Vector2));
+    enemies.spawnPositions      = (Vector2*) realloc(enemies.spawnPositions, capacity * sizeof(Vector2));
+    enemies.homePaths           = (PathFollower*) realloc(enemies.homePaths, capacity * sizeof(PathFollower));
+    enemies.animations          = (EnemyAnimations*) realloc(enemies.animations, capacity * sizeof(EnemyAnimations));
+    enemies.hasAttacked         = (bool*) realloc(enemies.hasAttacked, capacity * sizeof(bool));
+    enemies.isPlayerNear        = (bool*) realloc(enemies.isPlayerNear, capacity * sizeof(bool));
+    enemies.isPlayerSeen        = (bool*) realloc(enemies.isPlayerSeen, capacity * sizeof(bool));
+    enemies.isHittingPlayer     = (bool*) realloc(enemies.isHittingPlayer, capacity * sizeof(bool));
+    enemies.snapshot            = (Entity*) realloc(enemies.snapshot, capacity * sizeof(Entity));
+    enemies.isAwake             = (bool*) realloc(enemies.isAwake, capacity * sizeof(bool));
+    enemies.pendingTimes        = (float*) realloc(enemies.pendingTimes, capacity * sizeof(float));
+    enemies.stepTimes           = (float*) realloc(enemies.stepTimes, capacity * sizeof(float));
+    enemies.sortKeys            = (unsigned int*) realloc(enemies.sortKeys, capacity * sizeof(unsigned int));
+    enemies.sortSlots           = (int*) realloc(enemies.sortSlots, capacity * sizeof(int));
+    enemies.cellsX              = (int*) realloc(enemies.cellsX, capacity * sizeof(int));
+    enemies.cellsY              = (int*) realloc(enemies.cellsY, capacity * sizeof(int));
+    enemies.nextInCell          = (int*) realloc(enemies.nextInCell, capacity * sizeof(int));
+    enemies.ids                 = (int*) realloc(enemies.ids, capacity * sizeof(int));
+    enemies.idSlots             = (int*) realloc(enemies.idSlots, capacity * sizeof(int));
+    enemies.idGenerations       = (unsigned int*) realloc(enemies.idGenerations, capacity * sizeof(unsigned int));
+    enemies.freeIds             = (int*) realloc(enemies.freeIds, capacity * sizeof(int));
+
+    if(enemies.entities == NULL || enemies.positions == NULL || enemies.hitboxes == NULL ||
+       enemies.types == NULL || enemies.lastPlayerPositions == NULL ||
+       enemies.spawnPositions == NULL || enemies.homePaths == NULL || enemies.animations == NULL ||
+       enemies.hasAttacked == NULL || enemies.isPlayerNear == NULL || enemies.isPlayerSeen == NULL ||
+       enemies.isHittingPlayer == NULL || enemies.snapshot == NULL || enemies.isAwake == NULL ||
+       enemies.pendingTimes == NULL || enemies.stepTimes == NULL || enemies.sortKeys == NULL ||
+       enemies.sortSlots == NULL || enemies.cellsX == NULL || enemies.cellsY == NULL || enemies.nextInCell == NULL ||
+       enemies.ids == NULL || enemies.idSlots == NULL || enemies.idGenerations == NULL ||
+       enemies.freeIds == NULL) {
+        TraceLog(LOG_FATAL, "ENEMY-POOL.C (ResizeEnemyPool, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    // The new ids are pushed in reverse, so they are handed out in increasing order.
+    for(int id = capacity - 1; id >= oldCapacity; id--) {
+        enemies.idSlots[id]                     = -1;
+        enemies.idGenerations[id]               = 0;
+        enemies.freeIds[enemies.numOfFreeIds++] = id;
+    }
+    enemies.capacity = capacity;
+}
+
+void CopyEnemySlot(int from, int to) {
+    enemies.entities[to]            = enemies.entities[from];
+    enemies.positions[to]           = enemies.positions[from];
+    enemies.hitboxes[to]            = enemies.hitboxes[from];
+    enemies.types[to]               = enemies.types[from];
+    enemies.lastPlayerPositions[to] = enemies.lastPlayerPositions[from];
+    enemies.spawnPositions[to]      = enemies.spawnPositions[from];
+    enemies.homePaths[to]           = enemies.homePaths[from];
+    enemies.animations[to]          = enemies.animations[from];
+    enemies.hasAttacked[to]         = enemies.hasAttacked[from];
+    enemies.isPlayerNear[to]        = enemies.isPlayerNear[from];
+    enemies.isPlayerSeen[to]        = enemies.isPlayerSeen[from];
+    enemies.isHittingPlayer[to]     = enemies.isHittingPlayer[from];
+    enemies.isAwake[to]             = enemies.isAwake[from];
+    enemies.pendingTimes[to]        = enemies.pendingTimes[from];
+    enemies.stepTimes[to]           = enemies.stepTimes[from];
+    enemies.ids[to]                 = enemies.ids[from];
+
+    enemies.idSlots[enemies.ids[to]] = to;
+}
+
+bool SortEnemies() {
+    int numOfPairs     = 0;
+    int numOfUnordered = 0;
+
+    for(int slot = 0; slot < enemies.size; slot++) {
+        enemies.sortKeys[slot] = GetMortonCode(enemies.cellsX[slot], enemies.cellsY[slot]);
+        if(slot > 0 && enemies.types[slot - 1] == enemies.types[slot]) {
+            numOfPairs++;
+            if(enemies.sortKeys[slot - 1] > enemies.sortKeys[slot]) numOfUnordered++;
+        }
+    }
+    if(numOfUnordered * ENEMY_SORT_DISORDER <= numOfPairs) return false;
+
+    // The permutation needs one free slot to hold an enemy while the others move.
+    if(enemies.size == enemies.capacity) ResizeEnemyPool(2 * enemies.capacity);
+
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        int first = enemies.typeStarts[type];
+        int last  = enemies.typeStarts[type + 1];
+
+        for(int slot = first; slot < last; slot++) enemies.sortSlots[slot] = slot;
+        qsort(&enemies.sortSlots[first], last - first, sizeof(int), CompareEnemySlots);
+        PermuteEnemies(first, last);
+    }
+
+    // Inserted backwards, so each bucket lists its enemies in increasing slots.
+    ClearEnemyHash();
+    for(int slot = enemies.size - 1; slot >= 0; slot--) InsertEnemyInHash(slot);
+
+    TraceLog(LOG_DEBUG, "ENEMY-POOL.C (SortEnemies): %d of %d enemies were out of order, pool sorted.", numOfUnordered, enemies.size);
+    return true;
+}
+
+void PermuteEnemies(int first, int last) {
+    int temp = enemies.size;
+
+    // Follows each cycle of the permutation, sortSlots is marked with -1 once a slot is placed.
+    for(int slot = first; slot < last; slot++) {
+        if(enemies.sortSlots[slot] == -1) continue;
+        if(enemies.sortSlots[slot] == slot) {
+            enemies.sortSlots[slot] = -1;
+            continue;
+        }
+
+        CopyEnemySlot(slot, temp);
+        int hole = slot;
+        while(enemies.sortSlots[hole] != slot) {
+            int next = enemies.sortSlots[hole];
+            CopyEnemySlot(next, hole);
+            enemies.sortSlots[hole] = -1;
+            hole                    = next;
+        }
+        CopyEnemySlot(temp, hole);
+        enemies.sortSlots[hole] = -1;
+    }
+}
+
+unsigned int GetMortonCode(int cellX, int cellY) {
+    // Cells outside of the map are clamped, the code only needs to be close for close cells.
+    unsigned int x = cellX < 0 ? 0 : (unsigned int) cellX & 0xFFFF;
+    unsigned int y = cellY < 0 ? 0 : (unsigned int) cellY & 0xFFFF;
+
+    x = (x | (x << 8)) & 0x00FF00FF;
+    x = (x | (x << 4)) & 0x0F0F0F0F;
+    x = (x | (x << 2)) & 0x33333333;
+    x = (x | (x << 1)) & 0x55555555;
+
+    y = (y | (y << 8)) & 0x00FF00FF;
+    y = (y | (y << 4)) & 0x0F0F0F0F;
+    y = (y | (y << 2)) & 0x33333333;
+    y = (y | (y << 1)) & 0x55555555;
+
+    return x | (y << 1);
+}
+
+void UnloadEnemyPool() {
+    free(enemies.entities);
+    free(enemies.positions);
+    free(enemies.hitboxes);
+    free(enemies.types);
+    free(enemies.lastPlayerPositions);
+    free(enemies.spawnPositions);
+    free(enemies.homePaths);
+    free(enemies.animations);
+    free(enemies.hasAttacked);
+    free(enemies.isPlayerNear);
+    free(enemies.isPlayerSeen);
+    free(enemies.isHittingPlayer);
+    free(enemies.snapshot);
+    free(enemies.isAwake);
+    free(enemies.pendingTimes);
+    free(enemies.stepTimes);
+    free(enemies.reachedRegions);
+    free(enemies.sortKeys);
+    free(enemies.sortSlots);
+    free(enemies.cellsX);
+    free(enemies.cellsY);
+    free(enemies.nextInCell);
+    free(enemies.ids);
+    free(enemies.idSlots);
+    free(enemies.idGenerations);
+    free(enemies.freeIds);
+    enemies = (EnemyPool){ 0 };
+}
+
+static int CompareEnemySlots(const void* a, const void* b) {
+    int slotA = *(const int*) a;
+    int slotB = *(const int*) b;
+
+    if(enemies.sortKeys[slotA] != enemies.sortKeys[slotB]) {
+        return enemies.sortKeys[slotA] < enemies.sortKeys[slotB] ? -1 : 1;
+    }
+    // Enemies in the same cell keep their order.
+    return slotA - slotB;
+}
@@ -11,108 +11,69 @@
 
 #include "../include/enemy.h"
 
-int GetWidth(EnemyType type) {
-    int width = ENEMY_PABLO_WIDTH;
+//* ------------------------------------------
+//* GLOBAL VARIABLES
 
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: width = ENEMY_DEIGO_WIDTH; break;
-        case DEMON_WAFFLES: width = ENEMY_WAFFLES_WIDTH; break;
+const EnemyArchetype enemyArchetypes[MAX_ENEMY_TYPES] = {
+#define ENEMY_ARCHETYPE_ENTRY(type, width, height, attackWidth, attackHeight, idleTile, health, speed, ...) \
+    [type] = { width, height, attackWidth, attackHeight, idleTile, health, speed },
+    ENEMY_ARCHETYPES(ENEMY_ARCHETYPE_ENTRY)
+#undef ENEMY_ARCHETYPE_ENTRY
+};
 
-        default:
-            TraceLog(LOG_ERROR, "ENEMY-UTILS.C (GetAttackWidth, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
-    return width;
-}
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
 
-int GetHeight(EnemyType type) {
-    int height = ENEMY_PABLO_HEIGHT;
+/**
+ * Returns the archetype of the given enemy type.
+ *
+ * ! @attention returns the archetype of DEMON_PABLO if given an invalid type.
+ *
+ * @param type  The enemy type.
+ * @returns     A pointer to the archetype in enemyArchetypes.
+ */
+static const EnemyArchetype* GetArchetype(EnemyType type);
 
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: height = ENEMY_DEIGO_HEIGHT; break;
-        case DEMON_WAFFLES: height = ENEMY_WAFFLES_HEIGHT; break;
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
 
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetAttackHeight, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
-    return height;
+int GetWidth(EnemyType type) {
+    return GetArchetype(type)->width;
 }
 
-int GetAttackWidth(EnemyType type) {
-    int width = ENEMY_PABLO_ATTACK_WIDTH;
-
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: width = ENEMY_DEIGO_ATTACK_WIDTH; break;
-        case DEMON_WAFFLES: width = ENEMY_WAFFLES_ATTACK_WIDTH; break;
+int GetHeight(EnemyType type) {
+    return GetArchetype(type)->height;
+}
 
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetAttackWidth, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
-    return width;
+int GetAttackWidth(EnemyType type) {
+    return GetArchetype(type)->attackWidth;
 }
 
 int GetAttackHeight(EnemyType type) {
-    int height = ENEMY_PABLO_ATTACK_HEIGHT;
-
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: height = ENEMY_DEIGO_ATTACK_HEIGHT; break;
-        case DEMON_WAFFLES: height = ENEMY_WAFFLES_ATTACK_HEIGHT; break;
-
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetAttackHeight, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
-    return height;
+    return GetArchetype(type)->attackHeight;
 }
 
 void GetTiles(int* tiles, int size, EnemyType type) {
-    int tileNum = TILE_ENEMY_PABLO_IDLE;
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: tileNum = TILE_ENEMY_DIEGO_IDLE; break;
-        case DEMON_WAFFLES: tileNum = TILE_ENEMY_WAFFLES_IDLE; break;
+    int tileNum = GetArchetype(type)->idleTile;
 
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetTiles, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
     for(int i = 0; i < size; i++) {
         tiles[i] = tileNum++;
     };
 }
 
 int GetHealth(EnemyType type) {
-    int health = ENEMY_PABLO_HEALTH;
-
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: health = ENEMY_DIEGO_HEALTH; break;
-        case DEMON_WAFFLES: health = ENEMY_WAFFLES_HEALTH; break;
-
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetHealth, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
-    }
-    return health;
+    return GetArchetype(type)->health;
 }
 
 int GetSpeed(EnemyType type) {
-    int speed = ENEMY_PABLO_SPEED;
-
-    switch(type) {
-        case DEMON_PABLO: break;
-        case DEMON_DIEGO: speed = ENEMY_DIEGO_SPEED; break;
-        case DEMON_WAFFLES: speed = ENEMY_WAFFLES_SPEED; break;
+    return GetArchetype(type)->speed;
+}
 
-        default:
-            TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetSpeed, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
-            break;
+static const EnemyArchetype* GetArchetype(EnemyType type) {
+    // The cast also catches negative values, so valid types only pay for one comparison.
+    if((unsigned int) type >= MAX_ENEMY_TYPES) {
+        TraceLog(LOG_WARNING, "ENEMY-UTILS.C (GetArchetype, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
+        return &enemyArchetypes[DEMON_PABLO];
     }
-    return speed;
-}
\ No newline at end of file
+    return &enemyArchetypes[type];
+}
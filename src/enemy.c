@@ -6,11 +6,13 @@
  *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h> enemy.h, utils.h
+ *    @include <stdlib.h> enemy.h, flow-field.h, room-graph.h, utils.h
  *
  ***********************************************************************************************/
 
 #include "../include/enemy.h"
+#include "../include/flow-field.h"
+#include "../include/room-graph.h"
 #include "../include/utils.h"
 #include <stdlib.h>
 
@@ -19,58 +21,20 @@
 
 #define ENEMY_ATTACK_RANGE 30
 
-//* ------------------------------------------
-//* MACROS
-
-/** Shortcut macro to access an enemy's animation array. */
-#define enemyAnimArray enemy->animations.animationArr
-
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
 /**
- * Sets the animations for the enemy based upon the given EnemyType.
- *
- * ! @attention returns if given an invlaid type or a NULL enemy.
- * ! @note Allocates memory for the array in enemy.animations.
- */
-static void SetupEnemyAnimation(Entity* enemy, EnemyType type);
-
-/**
- * Determines if the player is seen by a given enemy.
- *
- * @param enemy The enemy to check agaist.
- * @param type  Type of enemy.
- * @returns     True if the player is seen and false otherwise.
- */
-static bool IsPlayerSeen(Entity* enemy, EnemyType type);
-
-/**
- * Updates the given enemy's attack hitbox property.
- *
- * @param enemy The enemy to update.
- * @param type  Type of enemy.
- */
-static void UpdateEnemyAttackHitbox(Entity* enemy, EnemyType type);
-
-/**
- * Renders an enemy's attack animation based off of it's Direction.
- *
- * @param enemy The enemy to render an attack for.
- * @param type  Type of enemy.
- */
-static void RenderEnemyAttack(Entity* enemy, EnemyType type);
-
-/**
- * Handles the enemy movement towards a given position.
+ * Steers the enemy towards a given position.
  *
  * @param enemy         The reference to the enemy to move.
  * @param position      The position to move the entity towards.
  * @param lastPlayerPos The last known position of the player relative to the given enemy.
+ * @returns             True if the enemy moves this step, false otherwise.
  *
- * ? @note Calls MoveEntityTowardsPos()
+ * ? @note Calls SteerEntityTowardsPos()
  */
-static void MoveEnemyToPos(Entity* enemy, Vector2 position, Vector2* lastPlayerPos);
+static bool MoveEnemyToPos(Entity* enemy, Vector2 position, Vector2* lastPlayerPos);
 
 /**
  * Sets the attack hitbox for the enemy: DEMON_WAFFLES.
@@ -86,25 +50,82 @@ static void LoadWafflesAttackHitbox(Entity* enemy);
  *
  * ! @attention enemy MUST be of entity DEMON_PABLO OR DEMON_DIEGO.
  *
- * @param enemy An enemy entity.
+ * @param enemy         An enemy entity.
+ * @param behaviour     Behaviour of the type of the enemy.
+ * @param animations    The animations state of the enemy.
  */
-static void RenderPabloDiegoAttack(Entity* enemy);
+static void RenderPabloDiegoAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations);
 
 /**
  * Renders the attack animation for: DEMON_WAFFLES.
  *
  * ! @attention enemy MUST be of entity DEMON_WAFFLES.
  *
- * @param enemy The waffles enemy.
+ * @param enemy         The waffles enemy.
+ * @param behaviour     Behaviour of DEMON_WAFFLES.
+ * @param animations    The animations state of the enemy.
  */
-static void RenderWafflesAttack(Entity* enemy);
+static void RenderWafflesAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations);
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** Animation data shared by all the enemies, indexed by EnemyType and AnimationType. */
+static AnimationDescriptor enemyAnimations[MAX_ENEMY_TYPES][MAX_ENEMY_ANIMATIONS];
+
+/** Behaviour of every EnemyType, generated from ENEMY_ARCHETYPES. */
+static const EnemyBehaviour enemyBehaviours[MAX_ENEMY_TYPES] = {
+#define ENEMY_BEHAVIOUR_ENTRY(type, width, height, attackWidth, attackHeight, idleTile, health, speed, loadAttackHitbox, renderAttack) \
+    [type] = { type, &enemyArchetypes[type], enemyAnimations[type], loadAttackHitbox, renderAttack },
+    ENEMY_ARCHETYPES(ENEMY_BEHAVIOUR_ENTRY)
+#undef ENEMY_BEHAVIOUR_ENTRY
+};
 
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
+void LoadEnemyAnimations() {
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        int width        = GetWidth(type);
+        int height       = GetHeight(type);
+        int attackWidth  = GetAttackWidth(type);
+        int attackHeight = GetAttackHeight(type);
+        int tiles[MAX_ENEMY_ANIMATIONS];
+        GetTiles(tiles, MAX_ENEMY_ANIMATIONS, type);
+
+        enemyAnimations[type][IDLE_ANIMATION] =
+            CreateAnimationDescriptor(DEFAULT_IDLE_FPS, width, height, tiles[0]);
+        enemyAnimations[type][MOVE_ANIMATION] =
+            CreateAnimationDescriptor(DEFAULT_MOVING_FPS, width, height, tiles[1]);
+        enemyAnimations[type][ATTACK_ANIMATION] =
+            CreateAnimationDescriptor(DEFAULT_ATTACK_FPS, attackWidth, attackHeight, tiles[2]);
+    }
+    TraceLog(LOG_INFO, "ENEMY.C (LoadEnemyAnimations): Enemy animations loaded successfully.");
+}
+
+const EnemyBehaviour* GetEnemyBehaviour(EnemyType type) {
+    if((unsigned int) type >= MAX_ENEMY_TYPES) {
+        TraceLog(LOG_WARNING, "ENEMY.C (GetEnemyBehaviour, line: %d): Invalid EnemyType given. Defaulting to PABLO.", __LINE__);
+        return &enemyBehaviours[DEMON_PABLO];
+    }
+    return &enemyBehaviours[type];
+}
+
+void UnloadEnemyAnimations() {
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        for(int i = 0; i < MAX_ENEMY_ANIMATIONS; i++) {
+            UnloadAnimationDescriptor(&enemyAnimations[type][i]);
+        }
+    }
+    TraceLog(LOG_INFO, "ENEMY.C (UnloadEnemyAnimations): Enemy animations unloaded successfully.");
+}
+
 Entity EnemyStartup(Vector2 position, EnemyType type) {
     Entity enemy;
     enemy.pos           = position;
+    enemy.prevPos       = position;
     enemy.direction     = Vector2Zero();
     enemy.faceValue     = 1;
     enemy.state         = IDLE;
@@ -120,42 +141,93 @@ Entity EnemyStartup(Vector2 position, EnemyType type) {
                                 .width  = width,
                                 .height = height / 2 };
 
-    SetupEnemyAnimation(&enemy, type);
+    enemy.animations = (AnimationArray){ 0 };
     TraceLog(LOG_INFO, "ENEMY.C (EnemyStartup): Enemy set successfully.");
     return enemy;
 }
 
-void EnemyMovement(Entity* enemy, Vector2* lastPlayerPos, EnemyType type) {
+void StartEnemyAnimations(EnemyAnimations* animations) {
+    *animations = (EnemyAnimations){ 0 };
+
+    StartTimer(&animations->states[IDLE_ANIMATION].timer, -1.0);
+    StartTimer(&animations->states[MOVE_ANIMATION].timer, -1.0);
+}
+
+bool EnemyMovement(
+    Entity* enemy, Vector2* lastPlayerPos, Vector2 spawnPos, PathFollower* homePath, EnemyType type,
+    bool isPlayerSeen, PathPlanner* planner) {
     if(enemy == NULL) {
         TraceLog(LOG_WARNING, "ENEMY.C (EnemyMovement, line: %d): NULL enemy was found.", __LINE__);
-        return;
+        return false;
     }
 
-    if(!IsPlayerSeen(enemy, type)) {
+    Vector2 hitboxCenter = (Vector2){ enemy->hitbox.x + enemy->hitbox.width / 2,
+                                      enemy->hitbox.y + enemy->hitbox.height / 2 };
+    Vector2 hitboxOffset = Vector2Subtract(hitboxCenter, enemy->pos);
+    Vector2 nextPos;
+
+    if(!isPlayerSeen) {
+        // Walks back to the spawn point along a cached path, straight to it once in the same tile.
+        if(homePath->isActive) {
+            if(IsVectorEqual(enemy->pos, spawnPos, 0.01f)) {
+                enemy->pos         = spawnPos;
+                enemy->state       = IDLE;
+                *lastPlayerPos     = spawnPos;
+                homePath->isActive = false;
+                return false;
+            }
+
+            if(FollowPath(&planner->jumpPointSearch, homePath, hitboxCenter, &nextPos)) {
+                return MoveEnemyToPos(enemy, Vector2Subtract(nextPos, hitboxOffset), lastPlayerPos);
+            }
+            return MoveEnemyToPos(enemy, spawnPos, lastPlayerPos);
+        }
+
         if(IsVectorEqual(enemy->pos, *lastPlayerPos, 0.01f)) {
             enemy->pos   = *lastPlayerPos;
             enemy->state = IDLE;
-        } else {
-            MoveEnemyToPos(enemy, *lastPlayerPos, lastPlayerPos);
+
+            // Once the last position of the player was checked, the enemy heads back home.
+            if(!IsVectorEqual(enemy->pos, spawnPos, 0.01f)) {
+                StartPath(&planner->jumpPointSearch, homePath, hitboxCenter, Vector2Add(spawnPos, hitboxOffset));
+            }
+            return false;
         }
-        return;
+
+        // Plans across the rooms toward the last position the player was seen at, walking
+        // straight to it once in the same tile (or if there is no path through the rooms).
+        if(GetRoomPathStep(
+               &planner->roomGraphSearch, hitboxCenter, Vector2Add(*lastPlayerPos, hitboxOffset), &nextPos)) {
+            return MoveEnemyToPos(enemy, Vector2Subtract(nextPos, hitboxOffset), lastPlayerPos);
+        }
+        return MoveEnemyToPos(enemy, *lastPlayerPos, lastPlayerPos);
     } else {
-        *lastPlayerPos = player.pos;
+        *lastPlayerPos     = player.pos;
+        homePath->isActive = false;
     }
 
-    MoveEnemyToPos(enemy, player.pos, lastPlayerPos);
+    // Follows the shared flow field from the center of the hitbox, walking straight to the
+    // player only once in the same tile (or if the player cannot be reached through the field).
+    if(GetFlowStep(hitboxCenter, &nextPos)) {
+        return MoveEnemyToPos(enemy, Vector2Subtract(nextPos, hitboxOffset), lastPlayerPos);
+    }
+
+    return MoveEnemyToPos(enemy, player.pos, lastPlayerPos);
 }
 
-void EnemyAttack(Entity* enemy, EnemyType type, bool* hasAttacked) {
+void EnemyAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations, bool* hasAttacked,
+    bool* isHittingPlayer, bool isPlayerNear) {
     if(enemy == NULL) {
         TraceLog(LOG_WARNING, "ENEMY.C (EnemyAttack, line: %d): NULL enemy was found.", __LINE__);
         return;
     }
 
-    float distance = Vector2Distance(enemy->pos, player.pos);
-    Timer* timer   = &enemyAnimArray[ATTACK_ANIMATION].timer;
+    Timer* timer = &animations->states[ATTACK_ANIMATION].timer;
 
-    if(distance <= ENEMY_ATTACK_RANGE && TimerDone(timer)) {
+    // ENEMY_ATTACK_RANGE is shorter than AGRO_RANGE, so far enemies skip the distance check.
+    if(isPlayerNear && Vector2Distance(enemy->pos, player.pos) <= ENEMY_ATTACK_RANGE &&
+       TimerDone(timer)) {
         *hasAttacked = false;
         enemy->state = MOVING;
         StartTimerWithDelay(timer, 0.5, 0.8);
@@ -169,38 +241,47 @@ void EnemyAttack(Entity* enemy, EnemyType type, bool* hasAttacked) {
         enemy->state = IDLE;
     }
 
-    if(enemyAnimArray[ATTACK_ANIMATION].curFrame == 1) {
-        UpdateEnemyAttackHitbox(enemy, type);
-        if(!(*hasAttacked)) {
-            if(EntityAttack(enemy, &player, 1)) {
-                *hasAttacked = true;
-                TraceLog(LOG_INFO, "ENEMY.C (EnemyAttack): Player was hit by enemy.");
-            }
+    if(animations->states[ATTACK_ANIMATION].curFrame == 1) {
+        behaviour->loadAttackHitbox(enemy);
+        // Same check as EntityAttack, the damage is only applied by CommitEnemyAttack.
+        if(!(*hasAttacked) && CheckCollisionRecs(enemy->attack, player.hitbox)) {
+            *hasAttacked     = true;
+            *isHittingPlayer = true;
         }
     }
 }
 
-void EnemyRender(Entity* enemy, EnemyType type) {
+void CommitEnemyAttack(Entity* enemy) {
+    if(EntityAttack(enemy, &player, 1)) {
+        TraceLog(LOG_INFO, "ENEMY.C (CommitEnemyAttack): Player was hit by enemy.");
+    }
+}
+
+Vector2 GetEnemyCenter(Entity* enemy, EnemyType type) {
+    return (Vector2){ enemy->pos.x + GetWidth(type) / 2, enemy->pos.y + GetHeight(type) / 2 };
+}
+
+void EnemyRender(Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations) {
     if(enemy == NULL) {
         TraceLog(LOG_WARNING, "ENEMY.C (EnemyRender, line: %d): NULL enemy was found.", __LINE__);
         return;
     }
 
-    int width  = GetWidth(type);
-    int height = GetHeight(type);
+    int width  = behaviour->archetype->width;
+    int height = behaviour->archetype->height;
 
     switch(enemy->state) {
         case IDLE:
-            EntityRender(
-                enemy, &enemyAnimArray[IDLE_ANIMATION],
+            EntityRenderState(
+                enemy, &behaviour->animations[IDLE_ANIMATION], &animations->states[IDLE_ANIMATION],
                 width * enemy->faceValue, height, 0, 0, 0.0f);
             break;
         case MOVING:
-            EntityRender(
-                enemy, &enemyAnimArray[MOVE_ANIMATION],
+            EntityRenderState(
+                enemy, &behaviour->animations[MOVE_ANIMATION], &animations->states[MOVE_ANIMATION],
                 width * enemy->faceValue, height, 0, 0, 0.0f);
             break;
-        case ATTACKING: RenderEnemyAttack(enemy, type); break;
+        case ATTACKING: behaviour->renderAttack(enemy, behaviour, animations); break;
         default:
             TraceLog(LOG_WARNING, "ENEMY.C (EnemyRender, line: %d): Invalid enemy state given.", __LINE__);
             break;
@@ -211,109 +292,12 @@ void EnemyUnload(Entity* enemy) {
     if(enemy == NULL) {
         TraceLog(LOG_FATAL, "ENEMY.C (EnemyUnload, line: %d): NULL enemy was given.", __LINE__);
     }
-    UnloadAnimationArray(&enemy->animations);
 
-    TraceLog(LOG_INFO, "ENEMY.C (EnemyUnload): Enemy animations unloaded successfully.");
     TraceLog(LOG_INFO, "ENEMY.C (EnemyUnload): Enemy unloaded successfully.");
 }
 
-static void UpdateEnemyAttackHitbox(Entity* enemy, EnemyType type) {
-    switch(type) {
-        case DEMON_DIEGO:
-        case DEMON_PABLO: LoadStandardEntityAttackHitbox(enemy); break;
-        case DEMON_WAFFLES: LoadWafflesAttackHitbox(enemy); break;
-        default:
-            TraceLog(LOG_WARNING, "ENEMY.C (UpdateEnemyAttackHitbox, line: %d): Invalid EnemyType was given.", __LINE__);
-            break;
-    }
-}
-
-static void RenderEnemyAttack(Entity* enemy, EnemyType type) {
-    switch(type) {
-        case DEMON_DIEGO:
-        case DEMON_PABLO: RenderPabloDiegoAttack(enemy); break;
-        case DEMON_WAFFLES: RenderWafflesAttack(enemy); break;
-        default:
-            TraceLog(LOG_WARNING, "ENEMY.C (UpdateEnemyAttackHitbox, line: %d): Invalid EnemyType was given.", __LINE__);
-            break;
-    }
-}
-
-static bool IsPlayerSeen(Entity* enemy, EnemyType type) {
-    if(enemy == NULL) {
-        TraceLog(LOG_WARNING, "ENEMY.C (IsPlayerSeen, line: %d): NULL enemy was found.", __LINE__);
-        return false;
-    }
-
-    // check if the enemy is in argo range
-    float distance = Vector2Distance(player.pos, enemy->pos);
-    if(distance > AGRO_RANGE) return false;
-
-    // check if the vector from enemy to player is clear of any collisions
-    float incrementAmount = 1 / distance;
-    int width             = GetWidth(type);
-    int height            = GetHeight(type);
-
-    for(float i = 0; i < 1.0f; i += incrementAmount) {
-        Vector2 playerCenter = { player.pos.x + ENTITY_TILE_WIDTH / 2,
-                                 player.pos.y + ENTITY_TILE_HEIGHT / 2 };
-        Vector2 enemyCenter = { enemy->pos.x + width / 2, enemy->pos.y + height / 2 };
-        Vector2 resVec = Vector2Lerp(playerCenter, enemyCenter, i);
-
-        CollisionNode* head = collidableTiles;
-        while(head != NULL) {
-            int x = (int) resVec.x / TILE_WIDTH;
-            int y = (int) resVec.y / TILE_HEIGHT;
-
-            if(x == head->collidedHitbox.index.x &&
-               y == head->collidedHitbox.index.y) {
-                return false;
-            }
-            head = head->next;
-        }
-    }
-    return true;
-}
-
-static void SetupEnemyAnimation(Entity* enemy, EnemyType type) {
-    if(enemy == NULL) {
-        TraceLog(LOG_WARNING, "ENEMY.C (SetupEnemyAnimation, line: %d): NULL enemy was given.", __LINE__);
-        return;
-    }
-
-    enemy->animations.size = MAX_ENEMY_ANIMATIONS;
-    enemyAnimArray = (Animation*) malloc(sizeof(Animation) * enemy->animations.size);
-
-    if(enemyAnimArray == NULL) {
-        TraceLog(LOG_FATAL, "ENEMY.C (SetupEnemyAnimation, line: %d): Memory allocation failure.", __LINE__);
-    }
-
-    int width        = GetWidth(type);
-    int height       = GetHeight(type);
-    int attackWidth  = GetAttackWidth(type);
-    int attackHeight = GetAttackHeight(type);
-    int tiles[MAX_ENEMY_ANIMATIONS];
-    GetTiles(tiles, MAX_ENEMY_ANIMATIONS, type);
-
-    Animation idleEnemyAnimation =
-        CreateAnimation(DEFAULT_IDLE_FPS, width, height, tiles[0]);
-
-    Animation movingEnemyAnimation =
-        CreateAnimation(DEFAULT_MOVING_FPS, width, height, tiles[1]);
-
-    Animation attackEnemyAnimation =
-        CreateAnimation(DEFAULT_ATTACK_FPS, attackWidth, attackHeight, tiles[2]);
-
-    enemyAnimArray[IDLE_ANIMATION]   = idleEnemyAnimation;
-    enemyAnimArray[MOVE_ANIMATION]   = movingEnemyAnimation;
-    enemyAnimArray[ATTACK_ANIMATION] = attackEnemyAnimation;
-
-    StartTimer(&enemyAnimArray[IDLE_ANIMATION].timer, -1.0);
-    StartTimer(&enemyAnimArray[MOVE_ANIMATION].timer, -1.0);
-}
-
-static void MoveEnemyToPos(Entity* enemy, Vector2 position, Vector2* lastPlayerPos) {
-    MoveEntityTowardsPos(enemy, position, lastPlayerPos);
+static bool MoveEnemyToPos(Entity* enemy, Vector2 position, Vector2* lastPlayerPos) {
+    return SteerEntityTowardsPos(enemy, position, lastPlayerPos);
 }
 
 static void LoadWafflesAttackHitbox(Entity* enemy) {
@@ -332,32 +316,39 @@ static void LoadWafflesAttackHitbox(Entity* enemy) {
     enemy->attack.y = floor(enemy->attack.y);
 }
 
-static void RenderPabloDiegoAttack(Entity* enemy) {
-    int width                  = ENEMY_PABLO_WIDTH;
-    int height                 = ENEMY_PABLO_HEIGHT;
-    int attackWidth            = ENEMY_PABLO_ATTACK_WIDTH;
-    int attackHeight           = ENEMY_PABLO_ATTACK_HEIGHT;
-    Animation* attackAnimation = &enemyAnimArray[ATTACK_ANIMATION];
+static void RenderPabloDiegoAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations) {
+    int width        = behaviour->archetype->width;
+    int height       = behaviour->archetype->height;
+    int attackWidth  = behaviour->archetype->attackWidth;
+    int attackHeight = behaviour->archetype->attackHeight;
+
+    const AnimationDescriptor* attackAnimation = &behaviour->animations[ATTACK_ANIMATION];
+    AnimationState* attackState                = &animations->states[ATTACK_ANIMATION];
 
-    EntityRender(enemy, &enemyAnimArray[IDLE_ANIMATION], width * enemy->faceValue, height, 0, 0, 0.0f);
+    EntityRenderState(
+        enemy, &behaviour->animations[IDLE_ANIMATION], &animations->states[IDLE_ANIMATION],
+        width * enemy->faceValue, height, 0, 0, 0.0f);
 
     switch(enemy->directionFace) {
         case RIGHT:
-            EntityRender(enemy, attackAnimation, -attackWidth, attackHeight, width / 4, attackHeight / 2, 0.0f);
+            EntityRenderState(
+                enemy, attackAnimation, attackState, -attackWidth, attackHeight, width / 4,
+                attackHeight / 2, 0.0f);
             break;
         case DOWN:
-            EntityRender(
-                enemy, attackAnimation, -attackWidth, attackHeight * enemy->faceValue,
+            EntityRenderState(
+                enemy, attackAnimation, attackState, -attackWidth, attackHeight * enemy->faceValue,
                 width + width / 8, attackHeight, 90.0f);
             break;
         case LEFT:
-            EntityRender(
-                enemy, attackAnimation, attackWidth, attackHeight,
+            EntityRenderState(
+                enemy, attackAnimation, attackState, attackWidth, attackHeight,
                 -width - width / 4, attackHeight / 2, 0.0f);
             break;
         case UP:
-            EntityRender(
-                enemy, attackAnimation, -attackWidth, -attackHeight * enemy->faceValue,
+            EntityRenderState(
+                enemy, attackAnimation, attackState, -attackWidth, -attackHeight * enemy->faceValue,
                 -width / 8, attackHeight + height / 8, -90.0f);
             break;
         default:
@@ -366,29 +357,35 @@ static void RenderPabloDiegoAttack(Entity* enemy) {
     }
 }
 
-static void RenderWafflesAttack(Entity* enemy) {
-    int width        = ENEMY_WAFFLES_WIDTH;
-    int height       = ENEMY_WAFFLES_HEIGHT;
-    int attackWidth  = ENEMY_WAFFLES_ATTACK_WIDTH;
-    int attackHeight = ENEMY_WAFFLES_ATTACK_HEIGHT;
+static void RenderWafflesAttack(
+    Entity* enemy, const EnemyBehaviour* behaviour, EnemyAnimations* animations) {
+    int width        = behaviour->archetype->width;
+    int height       = behaviour->archetype->height;
+    int attackWidth  = behaviour->archetype->attackWidth;
+    int attackHeight = behaviour->archetype->attackHeight;
+
+    const AnimationDescriptor* attackAnimation = &behaviour->animations[ATTACK_ANIMATION];
+    AnimationState* attackState                = &animations->states[ATTACK_ANIMATION];
 
-    Animation* attackAnimation = &enemyAnimArray[ATTACK_ANIMATION];
-    Animation idleAnimation    = enemyAnimArray[IDLE_ANIMATION];
-    idleAnimation.fps          = 10;
+    // The frames are shared, only the speed of the idle animation changes while attacking.
+    AnimationDescriptor idleAnimation = behaviour->animations[IDLE_ANIMATION];
+    idleAnimation.fps                 = 10;
 
     switch(enemy->faceValue) {
         case 1:
-            EntityRender(
-                enemy, attackAnimation, attackWidth, attackHeight,
+            EntityRenderState(
+                enemy, attackAnimation, attackState, attackWidth, attackHeight,
                 -attackWidth / 2 + width / 3, -height / 3, 0.0f);
             break;
         case -1:
-            EntityRender(
-                enemy, attackAnimation, attackWidth, attackHeight,
+            EntityRenderState(
+                enemy, attackAnimation, attackState, attackWidth, attackHeight,
                 -width + width / 8, -height / 3, 0.0f);
             break;
         default: break;
     }
     // Render IDLE
-    EntityRender(enemy, &idleAnimation, width * enemy->faceValue, height, 0, 0, 0.0f);
+    EntityRenderState(
+        enemy, &idleAnimation, &animations->states[IDLE_ANIMATION], width * enemy->faceValue,
+        height, 0, 0, 0.0f);
 }
\ No newline at end of file
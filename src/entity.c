@@ -6,11 +6,13 @@
  *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h> entity.h, utils.h
+ *    @include <stdlib.h> entity.h, collision-grid.h, screen.h, utils.h
  *
  ***********************************************************************************************/
 
 #include "../include/entity.h"
+#include "../include/collision-grid.h"
+#include "../include/screen.h"
 #include "../include/utils.h"
 #include <stdlib.h>
 
@@ -29,23 +31,65 @@
  */
 static void SetEntityStatebyDir(Entity* entity, Vector2* lastPlayerPos);
 
+/**
+ * Returns the destination rectangle to draw an entity's sprite at. The entity is drawn between
+ * its last two simulated positions.
+ *
+ * @param entity        The reference to the entity.
+ * @param entityWidth   Width of the entity (negative when flipped).
+ * @param entityHeight  Height of the entity (negative when flipped).
+ * @param xOffset       X-direction pixel offset from the current x of the entity.
+ * @param yOffset       Y-direction pixel offset from the current y of the entity.
+ * @returns             The destination rectangle in world coordinates.
+ */
+static Rectangle GetEntityRenderDest(
+    Entity* entity, int entityWidth, int entityHeight, int xOffset, int yOffset);
+
+/**
+ * Orders two entities on the exact same spot, so SeparateEntity pushes them apart.
+ *
+ * @param entity    The entity being separated.
+ * @param neighbour The neighbour it overlaps.
+ * @returns         True if entity goes first (left or above), false otherwise.
+ */
+static bool IsEntityBefore(Entity* entity, Entity* neighbour);
+
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
-void MoveEntityTowardsPos(Entity* entity, Vector2 position, Vector2* lastPlayerPos) {
+void MoveEntityTowardsPos(
+    Entity* entity, Vector2 position, Vector2* lastPlayerPos, Entity* neighbours[],
+    int numOfNeighbours, float deltaTime) {
+    if(!SteerEntityTowardsPos(entity, position, lastPlayerPos)) return;
+
+    //? Delta time helps to not let entity speed depend on framerate.
+    //? It is the fixed simulation step, so it does not grow when a frame takes longer.
+    //! NOTE: Do not add deltaTime before checking collisions only after.
+
+    entity->direction = Vector2Normalize(entity->direction);
+
+    // Velocity:
+    entity->direction = Vector2Scale(entity->direction, entity->speed);
+
+    CollideEntity(entity, lastPlayerPos, neighbours, numOfNeighbours, deltaTime);
+
+    entity->pos = Vector2Add(entity->pos, Vector2Scale(entity->direction, deltaTime));
+}
+
+bool SteerEntityTowardsPos(Entity* entity, Vector2 position, Vector2* lastPlayerPos) {
     if(entity == NULL) {
-        TraceLog(LOG_WARNING, "ENTITY-C (MoveEnemyTowardsPos, line: %d): NULL entity was given.", __LINE__);
-        return;
+        TraceLog(LOG_WARNING, "ENTITY-C (SteerEntityTowardsPos, line: %d): NULL entity was given.", __LINE__);
+        return false;
     }
 
     // Set state to idle if position is zero
     if(Vector2Equals(position, Vector2Zero())) {
         SetEntityStatebyDir(entity, NULL);
-        return;
+        return false;
     }
 
     // Ensures the entity cannot move while attacking
-    if(entity->state == ATTACKING) return;
+    if(entity->state == ATTACKING) return false;
 
 
     if(lastPlayerPos != NULL) {
@@ -88,21 +132,15 @@ void MoveEntityTowardsPos(Entity* entity, Vector2 position, Vector2* lastPlayerP
     }
 
     SetEntityStatebyDir(entity, lastPlayerPos);
+    return true;
+}
 
-    //? Delta time helps to not let entity speed depend on framerate.
-    //? It helps to take account for time between frames too.
-    //! NOTE: Do not add deltaTime before checking collisions only after.
-    float deltaTime = GetFrameTime();
-
-    entity->direction = Vector2Normalize(entity->direction);
-
-    // Velocity:
-    entity->direction = Vector2Scale(entity->direction, entity->speed);
-
-    EntityWorldCollision(entity);
+void CollideEntity(
+    Entity* entity, Vector2* lastPlayerPos, Entity* neighbours[], int numOfNeighbours,
+    float deltaTime) {
+    EntityWorldCollision(entity, deltaTime);
+    EntityNeighboursCollision(entity, neighbours, numOfNeighbours, deltaTime);
     SetEntityStatebyDir(entity, lastPlayerPos);
-
-    entity->pos = Vector2Add(entity->pos, Vector2Scale(entity->direction, deltaTime));
 }
 
 static void SetEntityStatebyDir(Entity* entity, Vector2* lastPlayerPos) {
@@ -124,11 +162,19 @@ void EntityRender(
     Entity* entity, Animation* animation, int entityWidth, int entityHeight,
     int xOffset, int yOffset, float rotation) {
     if(entity == NULL || animation == NULL) return;
+
     DrawAnimation(
-        animation,
-        (Rectangle){ (int) (entity->pos.x) + xOffset, (int) (entity->pos.y) + yOffset,
-                     entityWidth < 0 ? -entityWidth : entityWidth,
-                     entityHeight < 0 ? -entityHeight : entityHeight },
+        animation, GetEntityRenderDest(entity, entityWidth, entityHeight, xOffset, yOffset),
+        entityWidth, entityHeight, rotation);
+}
+
+void EntityRenderState(
+    Entity* entity, const AnimationDescriptor* descriptor, AnimationState* state,
+    int entityWidth, int entityHeight, int xOffset, int yOffset, float rotation) {
+    if(entity == NULL || descriptor == NULL || state == NULL) return;
+
+    DrawAnimationState(
+        descriptor, state, GetEntityRenderDest(entity, entityWidth, entityHeight, xOffset, yOffset),
         entityWidth, entityHeight, rotation);
 }
 
@@ -147,82 +193,147 @@ void UpdateEntityHitbox(Entity* entity) {
     entity->hitbox.y = entity->pos.y + entity->hitbox.height;
 }
 
-RayCollision2D EntityRectCollision(Entity entity, Rectangle hitboxTarget) {
+RayCollision2D EntityRectCollision(Entity entity, Rectangle hitboxTarget, float deltaTime) {
     RayCollision2D collision;
     collision.hit = false;
 
     if(Vector2Equals(entity.direction, Vector2Zero())) return collision;
 
-    collision = HitboxCollision(entity.hitbox, entity.direction, hitboxTarget);
+    collision = HitboxCollision(entity.hitbox, entity.direction, hitboxTarget, deltaTime);
     return collision;
 }
 
-RayCollision2D EntitiesCollision(Entity entityIn, Entity entityTarget) {
+RayCollision2D EntitiesCollision(Entity entityIn, Entity entityTarget, float deltaTime) {
     RayCollision2D collision;
     collision.hit = false;
 
     if(Vector2Equals(entityIn.direction, Vector2Zero())) return collision;
 
     collision =
-        HitboxCollision(entityIn.hitbox, entityIn.direction, entityTarget.hitbox);
+        HitboxCollision(entityIn.hitbox, entityIn.direction, entityTarget.hitbox, deltaTime);
     return collision;
 }
 
-void EntityWorldCollision(Entity* entity) {
-    if(collidableTiles == NULL) return;
+void EntityWorldCollision(Entity* entity, float deltaTime) {
+    if(collisionGrid.recs == NULL) return;
+    if(Vector2Equals(entity->direction, Vector2Zero())) return;
+
+    Vector2 displacement = Vector2Scale(entity->direction, deltaTime);
+    Vector2 hitboxCenter = { entity->hitbox.x + entity->hitbox.width / 2,
+                             entity->hitbox.y + entity->hitbox.height / 2 };
+
+    // Skips the collision checks when the closest wall is further than the hitbox can reach
+    // in this step (the hitbox reaches at most half its diagonal away from its center).
+    float wallDistance = SampleWallDistance(hitboxCenter) - WALL_DISTANCE_ERROR;
+    float hitboxReach  = Vector2Length(displacement) +
+        Vector2Length((Vector2){ entity->hitbox.width / 2, entity->hitbox.height / 2 });
+    if(wallDistance > hitboxReach) return;
+
+    // Broad phase: only the collision rectangles under the movement sweep of this step can be hit.
+    Rectangle tileHitboxes[MAX_SWEPT_RECS];
+    int numOfRecs =
+        GetSweptCollisionRecs(entity->hitbox, displacement, tileHitboxes, MAX_SWEPT_RECS);
+
+    // Narrow phase: the ray from the center of the hitbox is tested against all the
+    // expanded collision rectangles at once (same as EntityRectCollision for each one).
+    RectangleBatch expandedTiles;
+    expandedTiles.size = 0;
+
+    for(int i = 0; i < numOfRecs; i++) {
+        if(!AddRectangleToBatch(&expandedTiles, ExpandHitbox(entity->hitbox, tileHitboxes[i])))
+            break;
+    }
 
-    CollisionNode* entityCollisionList;
-    entityCollisionList = NULL;
+    Ray2D hitboxRay = (Ray2D){ .origin = hitboxCenter, .direction = displacement };
 
-    CollisionNode* collidingTile;
-    collidingTile = collidableTiles;
+    RayCollision2D tileCollisions[RECTANGLE_BATCH_CAPACITY];
+    RayRectBatchCollision(hitboxRay, &expandedTiles, NULL, tileCollisions);
 
-    while(collidingTile != NULL) {
-        RayCollision2D entityCollision;
-        Rectangle tileHitbox =
-            (Rectangle){ .x = collidingTile->collidedHitbox.index.x * TILE_WIDTH,
-                         .y = collidingTile->collidedHitbox.index.y * TILE_HEIGHT,
-                         .width  = TILE_WIDTH,
-                         .height = TILE_HEIGHT };
+    // Contacts are kept on the stack, so no memory is allocated while moving.
+    CollisionContact contacts[MAX_COLLISION_CONTACTS];
+    int numOfContacts = 0;
+
+    for(int i = 0; i < expandedTiles.size && numOfContacts < MAX_COLLISION_CONTACTS; i++) {
+        RayCollision2D entityCollision = tileCollisions[i];
+        if(entityCollision.hit == true && entityCollision.timeHit >= 0 &&
+           entityCollision.timeHit <= 1) {
+            contacts[numOfContacts++] = (CollisionContact){ tileHitboxes[i], entityCollision };
+        }
+    }
+
+    SortCollisionContacts(contacts, numOfContacts);
+
+    // Resolves the closest collisions first.
+    bool isDirectionChanged = false;
+    for(int i = 0; i < numOfContacts; i++) {
+        // The detection pass is still valid until a resolution changes the direction,
+        // after that the remaining contacts need to be checked again.
+        RayCollision2D entityCollision = contacts[i].collision;
+        if(isDirectionChanged)
+            entityCollision = EntityRectCollision(*entity, contacts[i].hitbox, deltaTime);
 
-        entityCollision = EntityRectCollision(*entity, tileHitbox);
         if(entityCollision.hit == true && entityCollision.timeHit >= 0) {
-            if(entityCollisionList == NULL)
-                entityCollisionList = CreateCollisionList(
-                    collidingTile->collidedHitbox.index.x,
-                    collidingTile->collidedHitbox.index.y, entityCollision.timeHit);
-            else
-                AddCollisionNode(
-                    entityCollisionList, collidingTile->collidedHitbox.index.x,
-                    collidingTile->collidedHitbox.index.y, entityCollision.timeHit);
+            Vector2 previousDirection = entity->direction;
+
+            entity->direction.x += entityCollision.normalVector.x *
+                ABS(entity->direction.x) * (1 - entityCollision.timeHit);
+            entity->direction.y += entityCollision.normalVector.y *
+                ABS(entity->direction.y) * (1 - entityCollision.timeHit);
+
+            if(!Vector2Equals(previousDirection, entity->direction)) isDirectionChanged = true;
         }
-        collidingTile = collidingTile->next;
     }
+}
 
-    if(entityCollisionList != NULL) {
-        SortCollisionList(entityCollisionList);
-
-        CollisionNode* resolvingNode = entityCollisionList;
-        while(resolvingNode != NULL) {
-            RayCollision2D entityCollision;
-            Rectangle tileHitbox =
-                (Rectangle){ .x = resolvingNode->collidedHitbox.index.x * TILE_WIDTH,
-                             .y = resolvingNode->collidedHitbox.index.y * TILE_HEIGHT,
-                             .width  = TILE_WIDTH,
-                             .height = TILE_HEIGHT };
-
-            entityCollision = EntityRectCollision(*entity, tileHitbox);
-            if(entityCollision.hit == true && entityCollision.timeHit >= 0) {
-                entity->direction.x += entityCollision.normalVector.x *
-                    ABS(entity->direction.x) * (1 - entityCollision.timeHit);
-                entity->direction.y += entityCollision.normalVector.y *
-                    ABS(entity->direction.y) * (1 - entityCollision.timeHit);
-            }
-            resolvingNode = resolvingNode->next;
+void EntityNeighboursCollision(
+    Entity* entity, Entity* neighbours[], int numOfNeighbours, float deltaTime) {
+    for(int i = 0; i < numOfNeighbours; i++) {
+        RayCollision2D entityCollision = EntitiesCollision(*entity, *neighbours[i], deltaTime);
+
+        // Negative time means the hitboxes already overlap, SeparateEntity handles that case.
+        if(entityCollision.hit == true && entityCollision.timeHit >= 0) {
+            entity->direction.x += entityCollision.normalVector.x *
+                ABS(entity->direction.x) * (1 - entityCollision.timeHit);
+            entity->direction.y += entityCollision.normalVector.y *
+                ABS(entity->direction.y) * (1 - entityCollision.timeHit);
         }
+    }
+}
+
+void SeparateEntity(Entity* entity, Entity* neighbours[], int numOfNeighbours) {
+    for(int i = 0; i < numOfNeighbours; i++) {
+        Rectangle neighbourHitbox = neighbours[i]->hitbox;
+        if(!CheckCollisionRecs(entity->hitbox, neighbourHitbox)) continue;
+
+        Rectangle overlap = GetCollisionRec(entity->hitbox, neighbourHitbox);
 
-        FreeCollisionList(entityCollisionList);
-        entityCollisionList = NULL;
+        float entityCenterX    = entity->hitbox.x + entity->hitbox.width / 2;
+        float entityCenterY    = entity->hitbox.y + entity->hitbox.height / 2;
+        float neighbourCenterX = neighbourHitbox.x + neighbourHitbox.width / 2;
+        float neighbourCenterY = neighbourHitbox.y + neighbourHitbox.height / 2;
+
+        // Entities on the exact same spot are split by where they were on the last step, then by
+        // their address, so both move apart.
+        bool isFirst = IsEntityBefore(entity, neighbours[i]);
+
+        Vector2 push = Vector2Zero();
+        if(overlap.width < overlap.height) {
+            bool isLeft = entityCenterX < neighbourCenterX ||
+                (entityCenterX == neighbourCenterX && isFirst);
+            push.x      = (isLeft ? -overlap.width : overlap.width) / 2;
+        } else {
+            bool isAbove = entityCenterY < neighbourCenterY ||
+                (entityCenterY == neighbourCenterY && isFirst);
+            push.y       = (isAbove ? -overlap.height : overlap.height) / 2;
+        }
+
+        Rectangle pushedHitbox = entity->hitbox;
+        pushedHitbox.x += push.x;
+        pushedHitbox.y += push.y;
+        if(IsRecSolid(pushedHitbox)) continue;
+
+        entity->hitbox = pushedHitbox;
+        entity->pos    = Vector2Add(entity->pos, push);
     }
 }
 
@@ -258,4 +369,19 @@ void LoadStandardEntityAttackHitbox(Entity* entity) {
     }
     entity->attack.x = floor(entity->attack.x);
     entity->attack.y = floor(entity->attack.y);
-}
\ No newline at end of file
+}
+
+static Rectangle GetEntityRenderDest(
+    Entity* entity, int entityWidth, int entityHeight, int xOffset, int yOffset) {
+    Vector2 renderPos = Vector2Lerp(entity->prevPos, entity->pos, renderAlpha);
+
+    return (Rectangle){ (int) (renderPos.x) + xOffset, (int) (renderPos.y) + yOffset,
+                        entityWidth < 0 ? -entityWidth : entityWidth,
+                        entityHeight < 0 ? -entityHeight : entityHeight };
+}
+
+static bool IsEntityBefore(Entity* entity, Entity* neighbour) {
+    if(entity->prevPos.x != neighbour->prevPos.x) return entity->prevPos.x < neighbour->prevPos.x;
+    if(entity->prevPos.y != neighbour->prevPos.y) return entity->prevPos.y < neighbour->prevPos.y;
+    return entity < neighbour;
+}
@@ -0,0 +1,166 @@
+/**********************************************************************************************
+ *
+ **   field-of-view.c is responsible for implementing the symmetric shadowcasting field of view
+ **   and its constant time lookups.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, <math.h>, field-of-view.h
+ *
+ **********************************************************************************************/
+
+#include "../include/field-of-view.h"
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+FieldOfView playerView;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Scans a row of a quadrant and recursively the rows behind it.
+ *
+ * @param quadrant      Quadrant being scanned (0 north, 1 east, 2 south, 3 west)
+ * @param depth         Distance of the row from the origin
+ * @param startSlope    Slope of the start of the visible part of the row
+ * @param endSlope      Slope of the end of the visible part of the row
+ */
+static void ScanRow(int quadrant, int depth, float startSlope, float endSlope);
+
+/**
+ * Transforms a (depth, column) coordinate of a quadrant into map tile coordinates.
+ */
+static void GetQuadrantTile(int quadrant, int depth, int col, int* x, int* y);
+
+/**
+ * Marks the tile at the (x, y) coordinate as visible.
+ */
+static void RevealTile(int x, int y);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateFieldOfView(int width, int height) {
+    playerView.visibleBits = (unsigned char*) calloc((width * height + 7) / 8, sizeof(unsigned char));
+    if(playerView.visibleBits == NULL) {
+        TraceLog(LOG_FATAL, "FIELD-OF-VIEW.C (CreateFieldOfView, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    playerView.width   = width;
+    playerView.height  = height;
+    playerView.originX = -1;
+    playerView.originY = -1;
+    playerView.radius  = 0;
+
+    TraceLog(LOG_INFO, "FIELD-OF-VIEW.C (CreateFieldOfView): Field of view of %dx%d tiles created.", width, height);
+}
+
+void UpdateFieldOfView(Vector2 origin, int radius) {
+    if(playerView.visibleBits == NULL) return;
+
+    int originX = (int) floorf(origin.x / TILE_WIDTH);
+    int originY = (int) floorf(origin.y / TILE_HEIGHT);
+    if(originX == playerView.originX && originY == playerView.originY && radius == playerView.radius)
+        return;
+
+    // Clears only the tiles the previous view could have revealed.
+    for(int y = playerView.originY - playerView.radius; y <= playerView.originY + playerView.radius; y++) {
+        for(int x = playerView.originX - playerView.radius; x <= playerView.originX + playerView.radius; x++) {
+            if(x < 0 || y < 0 || x >= playerView.width || y >= playerView.height) continue;
+            int bit = y * playerView.width + x;
+            playerView.visibleBits[bit / 8] &= ~(1 << (bit % 8));
+        }
+    }
+
+    playerView.originX = originX;
+    playerView.originY = originY;
+    playerView.radius  = radius;
+
+    RevealTile(originX, originY);
+    for(int quadrant = 0; quadrant < 4; quadrant++) ScanRow(quadrant, 1, -1.0f, 1.0f);
+}
+
+bool IsPosVisible(Vector2 pos) {
+    if(playerView.visibleBits == NULL) return false;
+
+    int x = (int) floorf(pos.x / TILE_WIDTH);
+    int y = (int) floorf(pos.y / TILE_HEIGHT);
+    if(x < 0 || y < 0 || x >= playerView.width || y >= playerView.height) return false;
+
+    int bit = y * playerView.width + x;
+    return (playerView.visibleBits[bit / 8] >> (bit % 8)) & 1;
+}
+
+void UnloadFieldOfView() {
+    free(playerView.visibleBits);
+    playerView.visibleBits = NULL;
+    playerView.width       = 0;
+    playerView.height      = 0;
+
+    TraceLog(LOG_INFO, "FIELD-OF-VIEW.C (UnloadFieldOfView): Field of view unloaded successfully.");
+}
+
+static void ScanRow(int quadrant, int depth, float startSlope, float endSlope) {
+    if(depth > playerView.radius) return;
+
+    // Columns whose centers are inside the visible part of the row (rounding ties outwards).
+    int minCol = (int) floorf(depth * startSlope + 0.5f);
+    int maxCol = (int) ceilf(depth * endSlope - 0.5f);
+
+    bool isPrevWall  = false;
+    bool hasPrevTile = false;
+
+    for(int col = minCol; col <= maxCol; col++) {
+        int x, y;
+        GetQuadrantTile(quadrant, depth, col, &x, &y);
+        bool isWall = IsSolid(x, y);
+
+        // Walls are always revealed, floors only if their center is inside the visible part,
+        // which keeps the visibility symmetric.
+        if(isWall || (col >= depth * startSlope && col <= depth * endSlope)) RevealTile(x, y);
+
+        // Slope of the left edge of this tile.
+        float tileSlope = (2.0f * col - 1.0f) / (2.0f * depth);
+
+        if(hasPrevTile && isPrevWall && !isWall) startSlope = tileSlope;
+        if(hasPrevTile && !isPrevWall && isWall) ScanRow(quadrant, depth + 1, startSlope, tileSlope);
+
+        isPrevWall  = isWall;
+        hasPrevTile = true;
+    }
+
+    if(hasPrevTile && !isPrevWall) ScanRow(quadrant, depth + 1, startSlope, endSlope);
+}
+
+static void GetQuadrantTile(int quadrant, int depth, int col, int* x, int* y) {
+    switch(quadrant) {
+        case 0:
+            *x = playerView.originX + col;
+            *y = playerView.originY - depth;
+            break;
+        case 1:
+            *x = playerView.originX + depth;
+            *y = playerView.originY + col;
+            break;
+        case 2:
+            *x = playerView.originX + col;
+            *y = playerView.originY + depth;
+            break;
+        default:
+            *x = playerView.originX - depth;
+            *y = playerView.originY + col;
+            break;
+    }
+}
+
+static void RevealTile(int x, int y) {
+    if(x < 0 || y < 0 || x >= playerView.width || y >= playerView.height) return;
+
+    int bit = y * playerView.width + x;
+    playerView.visibleBits[bit / 8] |= 1 << (bit % 8);
+}
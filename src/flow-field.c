@@ -0,0 +1,141 @@
+/**********************************************************************************************
+ *
+ **   flow-field.c is responsible for implementing the Dijkstra flow field and the steps read
+ **   from it.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, <math.h>, flow-field.h
+ *
+ **********************************************************************************************/
+
+#include "../include/flow-field.h"
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+FlowField playerFlowField;
+
+/** Offsets of the 8 neighbours of a tile (orthogonal ones first). */
+static const int NEIGHBOUR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOUR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateFlowField(int width, int height) {
+    int numOfTiles = width * height;
+
+    playerFlowField.costs   = (int*) malloc(numOfTiles * sizeof(int));
+    playerFlowField.reached = (int*) malloc(numOfTiles * sizeof(int));
+    if(playerFlowField.costs == NULL || playerFlowField.reached == NULL) {
+        TraceLog(LOG_FATAL, "FLOW-FIELD.C (CreateFlowField, line: %d): Memory allocation failure.", __LINE__);
+    }
+    CreateIndexHeap(&playerFlowField.heap, numOfTiles, playerFlowField.costs);
+
+    for(int i = 0; i < numOfTiles; i++) playerFlowField.costs[i] = FLOW_UNREACHABLE;
+
+    playerFlowField.width        = width;
+    playerFlowField.height       = height;
+    playerFlowField.goalX        = -1;
+    playerFlowField.goalY        = -1;
+    playerFlowField.numOfReached = 0;
+
+    TraceLog(LOG_INFO, "FLOW-FIELD.C (CreateFlowField): Flow field of %dx%d tiles created.", width, height);
+}
+
+void UpdateFlowField(Vector2 goal, int radius) {
+    if(playerFlowField.costs == NULL) return;
+
+    int goalX = (int) floorf(goal.x / TILE_WIDTH);
+    int goalY = (int) floorf(goal.y / TILE_HEIGHT);
+    if(goalX == playerFlowField.goalX && goalY == playerFlowField.goalY) return;
+
+    playerFlowField.goalX = goalX;
+    playerFlowField.goalY = goalY;
+
+    int width    = playerFlowField.width;
+    int* costs   = playerFlowField.costs;
+    int* reached = playerFlowField.reached;
+    int maxCost  = radius * STRAIGHT_STEP_COST;
+
+    IndexHeap* heap = &playerFlowField.heap;
+
+    // Only the tiles of the last build have a cost, the rest of the map is still unreachable.
+    for(int i = 0; i < playerFlowField.numOfReached; i++) costs[reached[i]] = FLOW_UNREACHABLE;
+    playerFlowField.numOfReached = 0;
+    if(IsSolid(goalX, goalY)) return;
+
+    costs[goalY * width + goalX]            = 0;
+    reached[playerFlowField.numOfReached++] = goalY * width + goalX;
+    PushIndexHeap(heap, goalY * width + goalX);
+
+    while(heap->size > 0) {
+        int tile = PopIndexHeap(heap);
+        int x    = tile % width;
+        int y    = tile / width;
+
+        for(int i = 0; i < 8; i++) {
+            if(!IsStepWalkable(x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i])) continue;
+
+            int next = (y + NEIGHBOUR_Y[i]) * width + x + NEIGHBOUR_X[i];
+            int cost = costs[tile] + (i < 4 ? STRAIGHT_STEP_COST : DIAGONAL_STEP_COST);
+            if(cost > maxCost) continue;
+
+            if(costs[next] == FLOW_UNREACHABLE) {
+                reached[playerFlowField.numOfReached++] = next;
+            } else if(cost >= costs[next]) {
+                continue;
+            }
+
+            costs[next] = cost;
+            PushIndexHeap(heap, next);
+        }
+    }
+}
+
+bool GetFlowStep(Vector2 pos, Vector2* nextPos) {
+    if(playerFlowField.costs == NULL) return false;
+
+    int x = (int) floorf(pos.x / TILE_WIDTH);
+    int y = (int) floorf(pos.y / TILE_HEIGHT);
+    if(x < 0 || y < 0 || x >= playerFlowField.width || y >= playerFlowField.height) return false;
+
+    int width    = playerFlowField.width;
+    int bestCost = playerFlowField.costs[y * width + x];
+    if(bestCost == FLOW_UNREACHABLE || bestCost == 0) return false;
+
+    // Walks to the neighbour closest to the goal.
+    int bestIdx = -1;
+    for(int i = 0; i < 8; i++) {
+        if(!IsStepWalkable(x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i])) continue;
+
+        int cost = playerFlowField.costs[(y + NEIGHBOUR_Y[i]) * width + x + NEIGHBOUR_X[i]];
+        if(cost != FLOW_UNREACHABLE && cost < bestCost) {
+            bestCost = cost;
+            bestIdx  = i;
+        }
+    }
+    if(bestIdx == -1) return false;
+
+    *nextPos = (Vector2){ (x + NEIGHBOUR_X[bestIdx] + 0.5f) * TILE_WIDTH,
+                          (y + NEIGHBOUR_Y[bestIdx] + 0.5f) * TILE_HEIGHT };
+    return true;
+}
+
+void UnloadFlowField() {
+    free(playerFlowField.costs);
+    free(playerFlowField.reached);
+    UnloadIndexHeap(&playerFlowField.heap);
+    playerFlowField.costs        = NULL;
+    playerFlowField.reached      = NULL;
+    playerFlowField.numOfReached = 0;
+    playerFlowField.width        = 0;
+    playerFlowField.height       = 0;
+
+    TraceLog(LOG_INFO, "FLOW-FIELD.C (UnloadFlowField): Flow field unloaded successfully.");
+}
+
@@ -0,0 +1,99 @@
+/**********************************************************************************************
+ *
+ **   index-heap.c is responsible for implementing the binary min-heap of indices.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, index-heap.h
+ *
+ **********************************************************************************************/
+
+#include "../include/index-heap.h"
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Swaps two positions of the heap, keeping the positions array updated.
+ */
+static void SwapIndexHeap(IndexHeap* heap, int posA, int posB);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateIndexHeap(IndexHeap* heap, int capacity, const int* keys) {
+    heap->items     = (int*) malloc(capacity * sizeof(int));
+    heap->positions = (int*) malloc(capacity * sizeof(int));
+    if(heap->items == NULL || heap->positions == NULL) {
+        TraceLog(LOG_FATAL, "INDEX-HEAP.C (CreateIndexHeap, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < capacity; i++) heap->positions[i] = -1;
+
+    heap->keys     = keys;
+    heap->size     = 0;
+    heap->capacity = capacity;
+}
+
+void PushIndexHeap(IndexHeap* heap, int item) {
+    int pos = heap->positions[item];
+    if(pos == -1) {
+        pos                   = heap->size++;
+        heap->items[pos]      = item;
+        heap->positions[item] = pos;
+    }
+
+    // Keys are only ever lowered, so the index only moves up.
+    while(pos > 0 && heap->keys[heap->items[(pos - 1) / 2]] > heap->keys[heap->items[pos]]) {
+        SwapIndexHeap(heap, pos, (pos - 1) / 2);
+        pos = (pos - 1) / 2;
+    }
+}
+
+int PopIndexHeap(IndexHeap* heap) {
+    int item = heap->items[0];
+    SwapIndexHeap(heap, 0, --heap->size);
+    heap->positions[item] = -1;
+
+    int pos = 0;
+    while(true) {
+        int left     = 2 * pos + 1;
+        int right    = left + 1;
+        int smallest = pos;
+
+        if(left < heap->size && heap->keys[heap->items[left]] < heap->keys[heap->items[smallest]])
+            smallest = left;
+        if(right < heap->size && heap->keys[heap->items[right]] < heap->keys[heap->items[smallest]])
+            smallest = right;
+        if(smallest == pos) break;
+
+        SwapIndexHeap(heap, pos, smallest);
+        pos = smallest;
+    }
+    return item;
+}
+
+void ClearIndexHeap(IndexHeap* heap) {
+    for(int i = 0; i < heap->size; i++) heap->positions[heap->items[i]] = -1;
+    heap->size = 0;
+}
+
+void UnloadIndexHeap(IndexHeap* heap) {
+    free(heap->items);
+    free(heap->positions);
+    heap->items     = NULL;
+    heap->positions = NULL;
+    heap->size      = 0;
+    heap->capacity  = 0;
+}
+
+static void SwapIndexHeap(IndexHeap* heap, int posA, int posB) {
+    int item          = heap->items[posA];
+    heap->items[posA] = heap->items[posB];
+    heap->items[posB] = item;
+
+    heap->positions[heap->items[posA]] = posA;
+    heap->positions[heap->items[posB]] = posB;
+}
@@ -0,0 +1,266 @@
+/**********************************************************************************************
+ *
+ **   jump-point-search.c is responsible for implementing the Jump Point Search pathfinder.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <limits.h>, <stdlib.h>, jump-point-search.h
+ *
+ **********************************************************************************************/
+
+#include "../include/jump-point-search.h"
+#include <limits.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Gets the directions worth searching from a jump point, pruning the ones that are reached at
+ * a lower or equal cost through its parent.
+ *
+ * @param search        Search expanding the jump point
+ * @param tile          Jump point to expand
+ * @param directionsX   Array of 8 entries that receives the horizontal direction of each neighbour
+ * @param directionsY   Array of 8 entries that receives the vertical direction of each neighbour
+ * @return              Number of directions written.
+ */
+static int GetPrunedDirections(const JumpPointSearch* search, int tile, int directionsX[], int directionsY[]);
+
+/**
+ * Walks from a tile in a direction until a jump point (goal or forced neighbour) is found.
+ *
+ * @param width Width of the map in tiles
+ * @param x     Horizontal (x) coordinate of the first tile of the jump
+ * @param y     Vertical (y) coordinate of the first tile of the jump
+ * @param dx    Horizontal direction (-1, 0 or 1)
+ * @param dy    Vertical direction (-1, 0 or 1)
+ * @param goal  Index of the goal tile
+ * @return      Index of the jump point found, or -1 if the jump hits a wall.
+ *
+ * ! @attention The step into the first tile must already be known to not cut a corner.
+ */
+static int Jump(int width, int x, int y, int dx, int dy, int goal);
+
+/**
+ * Octile distance between two tiles, the exact cost of a straight or diagonal line between them.
+ */
+static int GetOctileDistance(int width, int tileA, int tileB);
+
+/**
+ * Checks if a tile is inside the grid and not solid.
+ */
+static bool IsWalkable(int x, int y);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateJumpPointSearch(JumpPointSearch* search, int width, int height) {
+    int numOfTiles = width * height;
+
+    search->costs   = (int*) malloc(numOfTiles * sizeof(int));
+    search->scores  = (int*) malloc(numOfTiles * sizeof(int));
+    search->parents = (int*) malloc(numOfTiles * sizeof(int));
+    search->stamps  = (int*) calloc(numOfTiles, sizeof(int));
+    if(search->costs == NULL || search->scores == NULL ||
+       search->parents == NULL || search->stamps == NULL) {
+        TraceLog(LOG_FATAL, "JUMP-POINT-SEARCH.C (CreateJumpPointSearch, line: %d): Memory allocation failure.", __LINE__);
+    }
+    CreateIndexHeap(&search->heap, numOfTiles, search->scores);
+
+    search->width  = width;
+    search->height = height;
+    search->stamp  = 0;
+}
+
+int FindJumpPointPath(JumpPointSearch* search, int startTile, int goalTile, int waypoints[], int maxWaypoints, int* numOfExpanded) {
+    *numOfExpanded = 0;
+    if(search->costs == NULL) return -1;
+
+    int width = search->width;
+    if(!IsWalkable(startTile % width, startTile / width) || !IsWalkable(goalTile % width, goalTile / width))
+        return -1;
+    if(startTile == goalTile) return 0;
+
+    // Stamps are restarted before they overflow.
+    if(search->stamp == INT_MAX) {
+        for(int i = 0; i < width * search->height; i++) search->stamps[i] = 0;
+        search->stamp = 0;
+    }
+    int stamp = ++search->stamp;
+
+    int* costs      = search->costs;
+    int* scores     = search->scores;
+    int* parents    = search->parents;
+    int* stamps     = search->stamps;
+    IndexHeap* heap = &search->heap;
+
+    costs[startTile]   = 0;
+    scores[startTile]  = GetOctileDistance(width, startTile, goalTile);
+    parents[startTile] = -1;
+    stamps[startTile]  = stamp;
+    PushIndexHeap(heap, startTile);
+
+    bool isGoalFound = false;
+    while(heap->size > 0) {
+        int tile = PopIndexHeap(heap);
+        (*numOfExpanded)++;
+
+        if(tile == goalTile) {
+            isGoalFound = true;
+            break;
+        }
+
+        int directionsX[8], directionsY[8];
+        int numOfDirections = GetPrunedDirections(search, tile, directionsX, directionsY);
+
+        for(int i = 0; i < numOfDirections; i++) {
+            int dx        = directionsX[i];
+            int dy        = directionsY[i];
+            int jumpPoint = Jump(width, tile % width + dx, tile / width + dy, dx, dy, goalTile);
+            if(jumpPoint == -1) continue;
+
+            int cost = costs[tile] + GetOctileDistance(width, tile, jumpPoint);
+            if(stamps[jumpPoint] == stamp && cost >= costs[jumpPoint]) continue;
+
+            costs[jumpPoint]   = cost;
+            scores[jumpPoint]  = cost + GetOctileDistance(width, jumpPoint, goalTile);
+            parents[jumpPoint] = tile;
+            stamps[jumpPoint]  = stamp;
+            PushIndexHeap(heap, jumpPoint);
+        }
+    }
+    ClearIndexHeap(heap);
+
+    if(!isGoalFound) return -1;
+
+    // Walks the parents back from the goal, only writing the first maxWaypoints jump points.
+    int numOfWaypoints = 0;
+    for(int tile = goalTile; tile != startTile; tile = parents[tile]) numOfWaypoints++;
+
+    int idx = numOfWaypoints - 1;
+    for(int tile = goalTile; tile != startTile; tile = parents[tile], idx--) {
+        if(idx < maxWaypoints) waypoints[idx] = tile;
+    }
+
+    return numOfWaypoints < maxWaypoints ? numOfWaypoints : maxWaypoints;
+}
+
+void UnloadJumpPointSearch(JumpPointSearch* search) {
+    free(search->costs);
+    free(search->scores);
+    free(search->parents);
+    free(search->stamps);
+    UnloadIndexHeap(&search->heap);
+
+    *search = (JumpPointSearch){ 0 };
+}
+
+static int GetPrunedDirections(const JumpPointSearch* search, int tile, int directionsX[], int directionsY[]) {
+    int width  = search->width;
+    int x      = tile % width;
+    int y      = tile / width;
+    int parent = search->parents[tile];
+    int size   = 0;
+
+    // The start has no parent, every walkable neighbour is searched.
+    if(parent == -1) {
+        for(int dy = -1; dy <= 1; dy++) {
+            for(int dx = -1; dx <= 1; dx++) {
+                if((dx == 0 && dy == 0) || !IsStepWalkable(x, y, dx, dy)) continue;
+
+                directionsX[size]   = dx;
+                directionsY[size++] = dy;
+            }
+        }
+        return size;
+    }
+
+    int px = parent % width;
+    int py = parent / width;
+    int dx = (x > px) - (x < px);
+    int dy = (y > py) - (y < py);
+
+    if(dx != 0 && dy != 0) {
+        bool isNextXWalkable = IsWalkable(x + dx, y);
+        bool isNextYWalkable = IsWalkable(x, y + dy);
+
+        if(isNextYWalkable) {
+            directionsX[size]   = 0;
+            directionsY[size++] = dy;
+        }
+        if(isNextXWalkable) {
+            directionsX[size]   = dx;
+            directionsY[size++] = 0;
+        }
+        if(isNextXWalkable && isNextYWalkable) {
+            directionsX[size]   = dx;
+            directionsY[size++] = dy;
+        }
+        return size;
+    }
+
+    // Straight moves also turn to the sides, the forced neighbours of diagonals without corner
+    // cutting are the tiles beside the line.
+    // ? NOTE: (sideX, sideY) is the direction perpendicular to the movement.
+    int sideX = dy != 0;
+    int sideY = dx != 0;
+    bool isNextWalkable = IsWalkable(x + dx, y + dy);
+
+    for(int side = -1; side <= 1; side += 2) {
+        if(!IsWalkable(x + side * sideX, y + side * sideY)) continue;
+
+        if(isNextWalkable) {
+            directionsX[size]   = dx + side * sideX;
+            directionsY[size++] = dy + side * sideY;
+        }
+        directionsX[size]   = side * sideX;
+        directionsY[size++] = side * sideY;
+    }
+    if(isNextWalkable) {
+        directionsX[size]   = dx;
+        directionsY[size++] = dy;
+    }
+    return size;
+}
+
+static int Jump(int width, int x, int y, int dx, int dy, int goal) {
+    while(true) {
+        if(!IsWalkable(x, y)) return -1;
+
+        int tile = y * width + x;
+        if(tile == goal) return tile;
+
+        if(dx != 0 && dy != 0) {
+            // Diagonal moves stop where a straight jump would find a jump point.
+            if(Jump(width, x + dx, y, dx, 0, goal) != -1 || Jump(width, x, y + dy, 0, dy, goal) != -1) return tile;
+        } else if(dx != 0) {
+            if((IsWalkable(x, y - 1) && !IsWalkable(x - dx, y - 1)) ||
+               (IsWalkable(x, y + 1) && !IsWalkable(x - dx, y + 1)))
+                return tile;
+        } else {
+            if((IsWalkable(x - 1, y) && !IsWalkable(x - 1, y - dy)) ||
+               (IsWalkable(x + 1, y) && !IsWalkable(x + 1, y - dy)))
+                return tile;
+        }
+
+        // The next step must not cut a corner (always true for straight moves).
+        if(!IsWalkable(x + dx, y) || !IsWalkable(x, y + dy)) return -1;
+
+        x += dx;
+        y += dy;
+    }
+}
+
+static int GetOctileDistance(int width, int tileA, int tileB) {
+    int distX = abs(tileA % width - tileB % width);
+    int distY = abs(tileA / width - tileB / width);
+    int diag  = distX < distY ? distX : distY;
+
+    return STRAIGHT_STEP_COST * (distX + distY) + (DIAGONAL_STEP_COST - 2 * STRAIGHT_STEP_COST) * diag;
+}
+
+static bool IsWalkable(int x, int y) {
+    return !IsSolid(x, y);
+}
@@ -0,0 +1,260 @@
+/**********************************************************************************************
+ *
+ **   kinematics.c is responsible for implementing the vectorised integration of the movement
+ **   of batches of entities.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <math.h>, kinematics.h, <immintrin.h> (x86 builds only)
+ *
+ *    ? @note On GCC/Clang x86 builds the AVX2 path is always compiled (target attribute) and
+ *            picked at runtime when the CPU supports it, otherwise the SSE2 path runs. Building
+ *            with -mavx2 skips the CPU check.
+ *
+ **********************************************************************************************/
+
+#include "../include/kinematics.h"
+#include <math.h>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+#if defined(__AVX2__)
+/** AVX2 is enabled for the whole build, no CPU check is needed. */
+#define KINEMATICS_AVX2
+#define KINEMATICS_AVX2_TARGET
+#elif defined(__SSE2__) && defined(__GNUC__)
+/** AVX2 path compiled for the functions that use it only, picked at runtime. */
+#define KINEMATICS_AVX2
+#define KINEMATICS_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Normalises and scales the direction of a single mover of the batch.
+ *
+ * @param batch The batch of movers.
+ * @param i     Index of the mover.
+ */
+static void NormalizeVelocity(KinematicsBatch* batch, int i);
+
+/**
+ * Integrates the position of a single mover of the batch.
+ *
+ * @param batch The batch of movers.
+ * @param i     Index of the mover.
+ */
+static void IntegratePosition(KinematicsBatch* batch, int i);
+
+#if defined(KINEMATICS_AVX2)
+/**
+ * Checks if the CPU running the game supports AVX2.
+ *
+ * @returns 1 if it does, 0 otherwise.
+ */
+static int IsAvx2Supported();
+
+/**
+ * NormalizeBatchVelocities 8 movers at a time with AVX2.
+ *
+ * @param batch The batch of movers.
+ */
+static void NormalizeBatchVelocitiesAvx2(KinematicsBatch* batch);
+
+/**
+ * IntegrateBatchPositions 8 movers at a time with AVX2.
+ *
+ * @param batch The batch of movers.
+ */
+static void IntegrateBatchPositionsAvx2(KinematicsBatch* batch);
+#endif
+
+#if defined(__SSE2__)
+/**
+ * NormalizeBatchVelocities 4 movers at a time with SSE2.
+ *
+ * @param batch The batch of movers.
+ */
+static void NormalizeBatchVelocitiesSse2(KinematicsBatch* batch);
+
+/**
+ * IntegrateBatchPositions 4 movers at a time with SSE2.
+ *
+ * @param batch The batch of movers.
+ */
+static void IntegrateBatchPositionsSse2(KinematicsBatch* batch);
+#endif
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void NormalizeBatchVelocities(KinematicsBatch* batch) {
+#if defined(KINEMATICS_AVX2)
+    if(IsAvx2Supported()) {
+        NormalizeBatchVelocitiesAvx2(batch);
+        return;
+    }
+#endif
+
+#if defined(__SSE2__)
+    NormalizeBatchVelocitiesSse2(batch);
+#else
+    // Scalar fallback for builds without SSE2.
+    for(int i = 0; i < batch->size; i++) NormalizeVelocity(batch, i);
+#endif
+}
+
+void IntegrateBatchPositions(KinematicsBatch* batch) {
+#if defined(KINEMATICS_AVX2)
+    if(IsAvx2Supported()) {
+        IntegrateBatchPositionsAvx2(batch);
+        return;
+    }
+#endif
+
+#if defined(__SSE2__)
+    IntegrateBatchPositionsSse2(batch);
+#else
+    // Scalar fallback for builds without SSE2.
+    for(int i = 0; i < batch->size; i++) IntegratePosition(batch, i);
+#endif
+}
+
+#if defined(KINEMATICS_AVX2)
+static int IsAvx2Supported() {
+#if defined(__AVX2__)
+    return 1;
+#else
+    // Reads the CPU features libgcc detected at startup, cheap enough to call for every batch.
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static KINEMATICS_AVX2_TARGET void NormalizeBatchVelocitiesAvx2(KinematicsBatch* batch) {
+    const __m256 zero     = _mm256_setzero_ps();
+    const __m256 one      = _mm256_set1_ps(1.0f);
+    const __m256i zeroInt = _mm256_setzero_si256();
+
+    int i = 0;
+    for(; i + 8 <= batch->size; i += 8) {
+        __m256 dirX   = _mm256_loadu_ps(&batch->dirX[i]);
+        __m256 dirY   = _mm256_loadu_ps(&batch->dirY[i]);
+        __m256 speed  = _mm256_loadu_ps(&batch->speeds[i]);
+        __m256i flags = _mm256_loadu_si256((const __m256i*) &batch->isMoving[i]);
+
+        // Same operations as Vector2Normalize and Vector2Scale, so the results match exactly.
+        __m256 length  = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dirX, dirX), _mm256_mul_ps(dirY, dirY)));
+        __m256 ilength = _mm256_div_ps(one, length);
+        __m256 velX    = _mm256_mul_ps(_mm256_mul_ps(dirX, ilength), speed);
+        __m256 velY    = _mm256_mul_ps(_mm256_mul_ps(dirY, ilength), speed);
+
+        // Zero directions would divide by zero, they are masked out with the still movers.
+        __m256 mask = _mm256_and_ps(
+            _mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, zeroInt)), _mm256_cmp_ps(length, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(&batch->dirX[i], _mm256_blendv_ps(dirX, velX, mask));
+        _mm256_storeu_ps(&batch->dirY[i], _mm256_blendv_ps(dirY, velY, mask));
+    }
+
+    for(; i < batch->size; i++) NormalizeVelocity(batch, i);
+}
+
+static KINEMATICS_AVX2_TARGET void IntegrateBatchPositionsAvx2(KinematicsBatch* batch) {
+    const __m256i zeroInt = _mm256_setzero_si256();
+
+    int i = 0;
+    for(; i + 8 <= batch->size; i += 8) {
+        __m256 posX      = _mm256_loadu_ps(&batch->posX[i]);
+        __m256 posY      = _mm256_loadu_ps(&batch->posY[i]);
+        __m256 deltaTime = _mm256_loadu_ps(&batch->deltaTimes[i]);
+        __m256i flags    = _mm256_loadu_si256((const __m256i*) &batch->isMoving[i]);
+        __m256 mask      = _mm256_castsi256_ps(_mm256_cmpgt_epi32(flags, zeroInt));
+
+        __m256 nextX = _mm256_add_ps(posX, _mm256_mul_ps(_mm256_loadu_ps(&batch->dirX[i]), deltaTime));
+        __m256 nextY = _mm256_add_ps(posY, _mm256_mul_ps(_mm256_loadu_ps(&batch->dirY[i]), deltaTime));
+
+        _mm256_storeu_ps(&batch->posX[i], _mm256_blendv_ps(posX, nextX, mask));
+        _mm256_storeu_ps(&batch->posY[i], _mm256_blendv_ps(posY, nextY, mask));
+    }
+
+    for(; i < batch->size; i++) IntegratePosition(batch, i);
+}
+#endif
+
+#if defined(__SSE2__)
+static void NormalizeBatchVelocitiesSse2(KinematicsBatch* batch) {
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 one      = _mm_set1_ps(1.0f);
+    const __m128i zeroInt = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 4 <= batch->size; i += 4) {
+        __m128 dirX   = _mm_loadu_ps(&batch->dirX[i]);
+        __m128 dirY   = _mm_loadu_ps(&batch->dirY[i]);
+        __m128 speed  = _mm_loadu_ps(&batch->speeds[i]);
+        __m128i flags = _mm_loadu_si128((const __m128i*) &batch->isMoving[i]);
+
+        // Same operations as Vector2Normalize and Vector2Scale, so the results match exactly.
+        __m128 length  = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dirX, dirX), _mm_mul_ps(dirY, dirY)));
+        __m128 ilength = _mm_div_ps(one, length);
+        __m128 velX    = _mm_mul_ps(_mm_mul_ps(dirX, ilength), speed);
+        __m128 velY    = _mm_mul_ps(_mm_mul_ps(dirY, ilength), speed);
+
+        // Zero directions would divide by zero, they are masked out with the still movers.
+        __m128 mask = _mm_and_ps(
+            _mm_castsi128_ps(_mm_cmpgt_epi32(flags, zeroInt)), _mm_cmpgt_ps(length, zero));
+
+        // SSE2 has no blend, the lanes are selected with the mask bits.
+        _mm_storeu_ps(&batch->dirX[i], _mm_or_ps(_mm_and_ps(mask, velX), _mm_andnot_ps(mask, dirX)));
+        _mm_storeu_ps(&batch->dirY[i], _mm_or_ps(_mm_and_ps(mask, velY), _mm_andnot_ps(mask, dirY)));
+    }
+
+    for(; i < batch->size; i++) NormalizeVelocity(batch, i);
+}
+
+static void IntegrateBatchPositionsSse2(KinematicsBatch* batch) {
+    const __m128i zeroInt = _mm_setzero_si128();
+
+    int i = 0;
+    for(; i + 4 <= batch->size; i += 4) {
+        __m128 posX      = _mm_loadu_ps(&batch->posX[i]);
+        __m128 posY      = _mm_loadu_ps(&batch->posY[i]);
+        __m128 deltaTime = _mm_loadu_ps(&batch->deltaTimes[i]);
+        __m128i flags    = _mm_loadu_si128((const __m128i*) &batch->isMoving[i]);
+        __m128 mask      = _mm_castsi128_ps(_mm_cmpgt_epi32(flags, zeroInt));
+
+        __m128 nextX = _mm_add_ps(posX, _mm_mul_ps(_mm_loadu_ps(&batch->dirX[i]), deltaTime));
+        __m128 nextY = _mm_add_ps(posY, _mm_mul_ps(_mm_loadu_ps(&batch->dirY[i]), deltaTime));
+
+        _mm_storeu_ps(&batch->posX[i], _mm_or_ps(_mm_and_ps(mask, nextX), _mm_andnot_ps(mask, posX)));
+        _mm_storeu_ps(&batch->posY[i], _mm_or_ps(_mm_and_ps(mask, nextY), _mm_andnot_ps(mask, posY)));
+    }
+
+    for(; i < batch->size; i++) IntegratePosition(batch, i);
+}
+#endif
+
+static void NormalizeVelocity(KinematicsBatch* batch, int i) {
+    if(!batch->isMoving[i]) return;
+
+    float length = sqrtf(batch->dirX[i] * batch->dirX[i] + batch->dirY[i] * batch->dirY[i]);
+    if(length > 0) {
+        float ilength  = 1.0f / length;
+        batch->dirX[i] = batch->dirX[i] * ilength * batch->speeds[i];
+        batch->dirY[i] = batch->dirY[i] * ilength * batch->speeds[i];
+    }
+}
+
+static void IntegratePosition(KinematicsBatch* batch, int i) {
+    if(!batch->isMoving[i]) return;
+
+    batch->posX[i] = batch->posX[i] + batch->dirX[i] * batch->deltaTimes[i];
+    batch->posY[i] = batch->posY[i] + batch->dirY[i] * batch->deltaTimes[i];
+}
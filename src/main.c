@@ -31,12 +31,18 @@ GameScreen nextScreen;
 /** Closes the game if true. */
 bool isRunning;
 
+/** How far (0 to 1) the rendered frame is between the last two simulation steps. */
+float renderAlpha;
+
 //* ------------------------------------------
 //* MODULAR VARIABLES
 
 /** Timer to track the time the game has been paused for. */
 static Timer pauseTimer;
 
+/** Time (seconds) not yet simulated by the fixed simulation steps. */
+static float simulationTime;
+
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
@@ -117,6 +123,8 @@ static void GameUpdate() {
             case MAIN_MENU: MainMenuStartup(); break;
             case DUNGEON:
                 ResetTimer(&pauseTimer);
+                simulationTime = 0.0f;
+                renderAlpha    = 0.0f;
                 DungeonStartup();
                 UIScreenStartup();
                 break;
@@ -139,6 +147,19 @@ static void GameUpdate() {
             } else {
                 UIScreenUpdate(&pauseTimer);
                 DungeonUpdate();
+
+                // Runs the simulation in fixed steps, no matter how long the frame took.
+                // The frame time is capped so a hitch does not need too many steps to catch up.
+                float frameTime = GetFrameTime();
+                if(frameTime > MAX_SIMULATION_STEPS * SIMULATION_STEP)
+                    frameTime = MAX_SIMULATION_STEPS * SIMULATION_STEP;
+
+                simulationTime += frameTime;
+                while(simulationTime >= SIMULATION_STEP) {
+                    DungeonStep(SIMULATION_STEP);
+                    simulationTime -= SIMULATION_STEP;
+                }
+                renderAlpha = simulationTime / SIMULATION_STEP;
             }
             break;
         case FINAL_SCREEN: FinalScreenUpdate(); break;
@@ -155,6 +176,7 @@ static void GameRender() {
     switch(currentScreen) {
         case MAIN_MENU: MainMenuRender(); break;
         case DUNGEON:
+            DungeonCameraUpdate();
             BeginMode2D(camera);
             DungeonRender();
             EndMode2D();
@@ -0,0 +1,143 @@
+/**********************************************************************************************
+ *
+ **   path-cache.c is responsible for implementing the cache of paths and their followers.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <math.h>, path-cache.h
+ *
+ **********************************************************************************************/
+
+#include "../include/path-cache.h"
+#include <math.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+PathCache pathCache = { .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Gets the index of the tile under a point, or -1 if the point is outside of the grid.
+ */
+static int GetTileIndex(Vector2 pos);
+
+/**
+ * Drops all the paths of the cache when the collisionGrid changed since they were found.
+ *
+ * ! @attention The mutex of the cache must be locked.
+ */
+static void CheckPathCacheRevision();
+
+/**
+ * Logs the number of queries, the hit rate and the average number of jump points expanded by
+ * each search of the cache.
+ */
+static void LogPathCacheStats(TraceLogLevel logLevel);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void ClearPathCache() {
+    if(pathCache.numOfQueries > 0) LogPathCacheStats(LOG_INFO);
+
+    for(int i = 0; i < PATH_CACHE_SIZE; i++) pathCache.slots[i].path.startTile = -1;
+
+    pathCache.gridRevision  = collisionGrid.revision;
+    pathCache.numOfQueries  = 0;
+    pathCache.numOfHits     = 0;
+    pathCache.numOfSearches = 0;
+    pathCache.numOfExpanded = 0;
+}
+
+void GetCachedPath(
+    JumpPointSearch* search, const PathFollower* follower, int startTile, int goalTile, CachedPath* path) {
+    unsigned int hash   = (unsigned int) startTile * 2654435761u ^ (unsigned int) goalTile * 40503u;
+    PathCacheSlot* slot = &pathCache.slots[hash % PATH_CACHE_SIZE];
+
+    pthread_mutex_lock(&pathCache.mutex);
+    CheckPathCacheRevision();
+
+    // Paths a follower finds it searched itself are not shared, so they are left out of the stats.
+    bool isHit = slot->path.startTile == startTile && slot->path.goalTile == goalTile;
+    if(!isHit || slot->searcher != follower) {
+        pathCache.numOfQueries++;
+        if(isHit) pathCache.numOfHits++;
+        if(pathCache.numOfQueries % PATH_CACHE_LOG_INTERVAL == 0) LogPathCacheStats(LOG_DEBUG);
+    }
+    if(isHit) *path = slot->path;
+    pthread_mutex_unlock(&pathCache.mutex);
+    if(isHit) return;
+
+    // Two threads missing the same path at once both search it, the last one keeps the slot.
+    int numOfExpanded;
+    path->startTile      = startTile;
+    path->goalTile       = goalTile;
+    path->numOfWaypoints = FindJumpPointPath(search, startTile, goalTile, path->waypoints, MAX_PATH_WAYPOINTS, &numOfExpanded);
+
+    pthread_mutex_lock(&pathCache.mutex);
+    CheckPathCacheRevision();
+    slot->path     = *path;
+    slot->searcher = follower;
+    pathCache.numOfSearches++;
+    pathCache.numOfExpanded += numOfExpanded;
+    pthread_mutex_unlock(&pathCache.mutex);
+}
+
+void StartPath(JumpPointSearch* search, PathFollower* follower, Vector2 from, Vector2 to) {
+    int startTile      = GetTileIndex(from);
+    follower->goalTile = GetTileIndex(to);
+    follower->waypoint = 0;
+    follower->isActive = startTile != -1 && follower->goalTile != -1;
+
+    if(follower->isActive) {
+        GetCachedPath(search, follower, startTile, follower->goalTile, &follower->path);
+        follower->gridRevision = collisionGrid.revision;
+    }
+}
+
+bool FollowPath(JumpPointSearch* search, PathFollower* follower, Vector2 pos, Vector2* nextPos) {
+    int tile = GetTileIndex(pos);
+    if(!follower->isActive || tile == -1 || tile == follower->goalTile) return false;
+
+    CachedPath* path = &follower->path;
+
+    // Skips the waypoints already reached.
+    if(follower->waypoint < path->numOfWaypoints && tile == path->waypoints[follower->waypoint])
+        follower->waypoint++;
+
+    // Cut paths and paths found on an older grid are planned again from the current tile.
+    bool isCut = follower->waypoint >= path->numOfWaypoints && path->numOfWaypoints > 0;
+    if(isCut || follower->gridRevision != collisionGrid.revision) {
+        follower->waypoint     = 0;
+        follower->gridRevision = collisionGrid.revision;
+        GetCachedPath(search, follower, tile, follower->goalTile, path);
+    }
+    if(path->numOfWaypoints <= 0) return false;
+
+    int waypoint = path->waypoints[follower->waypoint];
+    int width    = collisionGrid.width;
+    *nextPos     = (Vector2){ (waypoint % width + 0.5f) * TILE_WIDTH, (waypoint / width + 0.5f) * TILE_HEIGHT };
+    return true;
+}
+
+static int GetTileIndex(Vector2 pos) {
+    int x = (int) floorf(pos.x / TILE_WIDTH);
+    int y = (int) floorf(pos.y / TILE_HEIGHT);
+    if(x < 0 || y < 0 || x >= collisionGrid.width || y >= collisionGrid.height) return -1;
+
+    return y * collisionGrid.width + x;
+}
+
+static void CheckPathCacheRevision() {
+    if(pathCache.gridRevision != collisionGrid.revision) ClearPathCache();
+}
+
+static void LogPathCacheStats(TraceLogLevel logLevel) {
+    TraceLog(logLevel, "PATH-CACHE.C (LogPathCacheStats): %d path queries, %.1f%% cache hits, %.1f jump points expanded per search.",
+             pathCache.numOfQueries, 100.0f * pathCache.numOfHits / pathCache.numOfQueries,
+             pathCache.numOfSearches > 0 ? (float) pathCache.numOfExpanded / pathCache.numOfSearches : 0.0f);
+}
@@ -0,0 +1,50 @@
+/**********************************************************************************************
+ *
+ **   path-planner.c is responsible for implementing the creation of the path planners of the
+ **   worker threads.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdlib.h>, path-planner.h, worker-pool.h
+ *
+ **********************************************************************************************/
+
+#include "../include/path-planner.h"
+#include "../include/worker-pool.h"
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+PathPlanner* pathPlanners = NULL;
+int numOfPathPlanners     = 0;
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreatePathPlanners() {
+    numOfPathPlanners = GetNumOfWorkers();
+    pathPlanners      = (PathPlanner*) malloc(numOfPathPlanners * sizeof(PathPlanner));
+    if(pathPlanners == NULL) {
+        TraceLog(LOG_FATAL, "PATH-PLANNER.C (CreatePathPlanners, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < numOfPathPlanners; i++) {
+        CreateJumpPointSearch(&pathPlanners[i].jumpPointSearch, collisionGrid.width, collisionGrid.height);
+        CreateRoomGraphSearch(&pathPlanners[i].roomGraphSearch);
+    }
+
+    TraceLog(LOG_INFO, "PATH-PLANNER.C (CreatePathPlanners): %d path planners created.", numOfPathPlanners);
+}
+
+void UnloadPathPlanners() {
+    for(int i = 0; i < numOfPathPlanners; i++) {
+        UnloadJumpPointSearch(&pathPlanners[i].jumpPointSearch);
+        UnloadRoomGraphSearch(&pathPlanners[i].roomGraphSearch);
+    }
+    free(pathPlanners);
+
+    pathPlanners      = NULL;
+    numOfPathPlanners = 0;
+}
@@ -6,13 +6,13 @@
  *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h>, player.h, audio.h, enemy-list.h, utils.h
+ *    @include <stdlib.h>, player.h, audio.h, enemy-hash.h, utils.h
  *
  ***********************************************************************************************/
 
 #include "../include/player.h"
 #include "../include/audio.h"
-#include "../include/enemy-list.h"
+#include "../include/enemy-hash.h"
 #include "../include/utils.h"
 #include <stdlib.h>
 
@@ -33,13 +33,21 @@ Entity player;
 /** Timer for the step sfx of the player. */
 static Timer playerStepTimer;
 
+/** Indicates if the attack key was pressed since the last simulation step. */
+static bool isAttackPressed;
+
+/** Enemies overlapping the attack hitbox of the player. */
+static EnemyQuery attackQuery;
+
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
 
 /**
  * Handles player movement and updates it's GameState and Direction.
+ *
+ * @param deltaTime Duration of the simulation step in seconds.
  */
-static void PlayerMovement();
+static void PlayerMovement(float deltaTime);
 
 /**
  * Handles the player's attack.
@@ -56,25 +64,26 @@ static void RenderPlayerAttack();
 /**
  * Checks if the player has hit an enemy.
  *
- * @param attackHitbox Hitbox of the attack that will check the detection with
- *                     all the enemies
+ * ? @note Only checks the enemies found by CollectEnemiesInRect around the attack hitbox.
  */
 static void PlayerAttackHit();
 
 /**
  * Handles the player movement towards a given position.
  *
- * @param position The position to move the player to.
+ * @param position  The position to move the player to.
+ * @param deltaTime Duration of the simulation step in seconds.
  *
  * ? @note Calls MoveEntityTowardsPos()
  */
-static void MovePlayerToPos(Vector2 position);
+static void MovePlayerToPos(Vector2 position, float deltaTime);
 
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
 void PlayerStartup() {
     player.pos = (Vector2){ (float) 11 * TILE_WIDTH, (float) 4 * TILE_HEIGHT };
+    player.prevPos       = player.pos;
     player.hitbox        = (Rectangle){ .x     = player.pos.x,
                                         .y     = player.pos.y + ENTITY_TILE_HEIGHT / 2,
                                         .width = ENTITY_TILE_WIDTH,
@@ -108,6 +117,7 @@ void PlayerStartup() {
     StartTimer(&playerAnimArray[MOVE_ANIMATION].timer, -1.0);
 
     playerStepTimer = (Timer){ 0.0, 0.0 };
+    isAttackPressed = false;
     StartTimer(&playerStepTimer, 0.45);
 
     TraceLog(LOG_INFO, "PLAYER.C (PlayerStartup): Player set successfully.");
@@ -132,16 +142,23 @@ void PlayerRender() {
 
 void PlayerUnload() {
     UnloadAnimationArray(&player.animations);
+    UnloadEnemyQuery(&attackQuery);
     TraceLog(LOG_INFO, "PLAYER.C (PlayerUnload): Player animations unloaded successfully.");
 }
 
-void PlayerUpdate() {
+void PlayerInput() {
+    if(IsKeyPressed(KEY_E)) isAttackPressed = true;
+}
+
+void PlayerUpdate(float deltaTime) {
+    player.prevPos = player.pos;
+
     UpdateEntityHitbox(&player);
-    PlayerMovement();
+    PlayerMovement(deltaTime);
     PlayerAttack();
 }
 
-static void PlayerMovement() {
+static void PlayerMovement(float deltaTime) {
     player.direction = Vector2Zero();
 
     if(player.state == ATTACKING) return;
@@ -169,13 +186,16 @@ static void PlayerMovement() {
         StartTimer(&playerStepTimer, playerStepTimer.lifeTime);
     }
 
-    MovePlayerToPos(player.direction);
+    MovePlayerToPos(player.direction, deltaTime);
 }
 
 static void PlayerAttack() {
     Timer* timer = &playerAnimArray[ATTACK_ANIMATION].timer;
 
-    if(IsKeyPressed(KEY_E) && player.state != ATTACKING) {
+    bool isAttackStarted = isAttackPressed && player.state != ATTACKING;
+    isAttackPressed      = false;
+
+    if(isAttackStarted) {
         player.state = ATTACKING;
         StartTimer(timer, 0.5);
         PlaySound(soundFX[PLAYER_SLASH_SFX]);
@@ -190,16 +210,16 @@ static void PlayerAttack() {
 }
 
 static void PlayerAttackHit() {
-    EnemyNode* currEnemy = enemies;
-    bool soundHit        = false;
+    // Only the enemies overlapping the attack hitbox can be hit.
+    CollectEnemiesInRect(player.attack, &attackQuery);
+    bool soundHit = false;
 
-    while(currEnemy != NULL) {
-        Entity* enemy = &currEnemy->enemy;
+    for(int i = 0; i < attackQuery.size; i++) {
+        Entity* enemy = &enemies.entities[attackQuery.slots[i]];
         if(EntityAttack(&player, enemy, 1) && !soundHit) {
             PlaySound(soundFX[ENEMY_DEAD_SFX]);
             soundHit = false;
         }
-        currEnemy = currEnemy->next;
     }
 }
 
@@ -239,6 +259,6 @@ static void RenderPlayerAttack() {
     }
 }
 
-static void MovePlayerToPos(Vector2 position) {
-    MoveEntityTowardsPos(&player, position, NULL);
+static void MovePlayerToPos(Vector2 position, float deltaTime) {
+    MoveEntityTowardsPos(&player, position, NULL, NULL, 0, deltaTime);
 }
\ No newline at end of file
@@ -0,0 +1,559 @@
+/***********************************************************************************************
+ *
+ **   Provides functionality for the hierarchical path search (HPA*) over the rooms.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <limits.h>, <math.h>, <stdlib.h>, room-graph.h
+ *
+ ***********************************************************************************************/
+
+#include "../include/room-graph.h"
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+RoomGraph roomGraph;
+
+/** Offsets of the 8 neighbours of a tile (orthogonal ones first). */
+static const int NEIGHBOUR_X[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+static const int NEIGHBOUR_Y[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Finds the entrances between regions and creates the two nodes of each one, grouped by region.
+ */
+static void BuildRoomGraphNodes();
+
+/**
+ * Lists the tiles of every region, grouped by region, and the index of each tile in the list.
+ */
+static void BuildRegionTiles();
+
+/**
+ * Finds the representative of a set of crossings (union-find with path halving).
+ */
+static int FindCrossingSet(int* sets, int crossing);
+
+/**
+ * Dijkstra search from a tile over the tiles of a single region.
+ *
+ * ? @note Afterwards, a tile was reached only if its tileStamps is equal to the stamp of the search.
+ */
+static void SearchRegion(RoomGraphSearch* search, int startTile, int region);
+
+/**
+ * Checks if a tile was reached by the last SearchRegion.
+ */
+static bool IsTileReached(const RoomGraphSearch* search, int tile);
+
+/**
+ * Gets the costs to a goal tile from the cache of the search, searching them if they are not there.
+ *
+ * @param search        Search whose cache is used.
+ * @param goalTile      Index of the goal tile.
+ * @param goalRegion    Region of the goal tile.
+ * @returns             Reference to the costs in the cache, valid until goal that is not
+ *                      in the cache is requested.
+ */
+static const RoomGoal* GetRoomGoal(RoomGraphSearch* search, int goalTile, int goalRegion);
+
+/**
+ * Walking cost from a tile to the goal: straight to it inside the goal room, or through the
+ * cheapest entrance of the room of the tile.
+ *
+ * @returns The cost, or ROOM_PATH_UNREACHABLE if the goal cannot be reached from the tile.
+ */
+static int GetCostToGoal(const RoomGoal* goal, int goalRegion, int tile);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void BuildRoomGraph() {
+    int numOfRegions = roomRegions.numOfRegions;
+
+    BuildRoomGraphNodes();
+    BuildRegionTiles();
+    int numOfNodes = roomGraph.numOfNodes;
+
+    // Each node has an edge to its partner plus one to every other node of its region, and the
+    // costs to every tile of its region.
+    int maxEdges      = 0;
+    int numOfTileCosts = 0;
+    for(int region = 0; region < numOfRegions; region++) {
+        int regionSize = roomGraph.regionFirstNode[region + 1] - roomGraph.regionFirstNode[region];
+        int numOfTiles = roomGraph.regionFirstTile[region + 1] - roomGraph.regionFirstTile[region];
+        maxEdges += regionSize * regionSize;
+        numOfTileCosts += regionSize * numOfTiles;
+    }
+
+    roomGraph.edges         = (RoomGraphEdge*) malloc((maxEdges + 1) * sizeof(RoomGraphEdge));
+    roomGraph.nodeTileCosts = (int*) malloc((numOfTileCosts + 1) * sizeof(int));
+    if(roomGraph.edges == NULL || roomGraph.nodeTileCosts == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRoomGraph, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    // Only needed while the graph is built, the searches of the paths have their own.
+    RoomGraphSearch search;
+    CreateRoomGraphSearch(&search);
+
+    // Intra-room costs, one search inside the room from each of its nodes.
+    int numOfEdges = 0;
+    int firstCost  = 0;
+    for(int region = 0; region < numOfRegions; region++) {
+        int first     = roomGraph.regionFirstNode[region];
+        int last      = roomGraph.regionFirstNode[region + 1];
+        int firstTile = roomGraph.regionFirstTile[region];
+        int lastTile  = roomGraph.regionFirstTile[region + 1];
+
+        for(int node = first; node < last; node++) {
+            RoomGraphNode* graphNode = &roomGraph.nodes[node];
+            graphNode->firstEdge     = numOfEdges;
+            graphNode->firstTileCost = firstCost;
+            roomGraph.edges[numOfEdges++] = (RoomGraphEdge){ graphNode->partner, STRAIGHT_STEP_COST };
+
+            SearchRegion(&search, graphNode->tile, region);
+            for(int other = first; other < last; other++) {
+                int otherTile = roomGraph.nodes[other].tile;
+                if(other == node || !IsTileReached(&search, otherTile)) continue;
+
+                roomGraph.edges[numOfEdges++] =
+                    (RoomGraphEdge){ other, search.tileCosts[otherTile] };
+            }
+            graphNode->numOfEdges = numOfEdges - graphNode->firstEdge;
+
+            for(int slot = firstTile; slot < lastTile; slot++) {
+                int tile = roomGraph.regionTiles[slot];
+                roomGraph.nodeTileCosts[firstCost++] = IsTileReached(&search, tile) ?
+                    search.tileCosts[tile] : ROOM_PATH_UNREACHABLE;
+            }
+        }
+    }
+    roomGraph.numOfEdges = numOfEdges;
+    UnloadRoomGraphSearch(&search);
+
+    TraceLog(LOG_INFO, "ROOM-GRAPH.C (BuildRoomGraph): Room graph with %d entrances and %d edges built.",
+             numOfNodes / 2, numOfEdges);
+}
+
+void CreateRoomGraphSearch(RoomGraphSearch* search) {
+    int numOfTiles = roomRegions.width * roomRegions.height;
+    int numOfNodes = roomGraph.numOfNodes;
+
+    // One extra node and tile so the arrays are never empty.
+    search->tileCosts  = (int*) malloc(numOfTiles * sizeof(int));
+    search->tileStamps = (int*) calloc(numOfTiles, sizeof(int));
+    search->nodeCosts  = (int*) malloc((numOfNodes + 1) * sizeof(int));
+    if(search->tileCosts == NULL || search->tileStamps == NULL || search->nodeCosts == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (CreateRoomGraphSearch, line: %d): Memory allocation failure.", __LINE__);
+    }
+    CreateIndexHeap(&search->tileHeap, numOfTiles, search->tileCosts);
+    CreateIndexHeap(&search->nodeHeap, numOfNodes + 1, search->nodeCosts);
+    search->stamp = 0;
+
+    for(int i = 0; i < ROOM_GOAL_CACHE_SIZE; i++) {
+        RoomGoal* goal  = &search->goals[i];
+        goal->goalTile  = -1;
+        goal->tileCosts = (int*) malloc((roomGraph.maxRegionSize + 1) * sizeof(int));
+        goal->nodeCosts = (int*) malloc((numOfNodes + 1) * sizeof(int));
+        if(goal->tileCosts == NULL || goal->nodeCosts == NULL) {
+            TraceLog(LOG_FATAL, "ROOM-GRAPH.C (CreateRoomGraphSearch, line: %d): Memory allocation failure.", __LINE__);
+        }
+    }
+    search->nextGoal = 0;
+}
+
+bool GetRoomPathStep(RoomGraphSearch* search, Vector2 from, Vector2 to, Vector2* nextPos) {
+    if(roomGraph.nodes == NULL) return false;
+
+    int width  = roomRegions.width;
+    int height = roomRegions.height;
+
+    int fromX = (int) floorf(from.x / TILE_WIDTH);
+    int fromY = (int) floorf(from.y / TILE_HEIGHT);
+    int toX   = (int) floorf(to.x / TILE_WIDTH);
+    int toY   = (int) floorf(to.y / TILE_HEIGHT);
+    if(fromX < 0 || fromY < 0 || fromX >= width || fromY >= height) return false;
+    if(toX < 0 || toY < 0 || toX >= width || toY >= height) return false;
+
+    int startTile   = fromY * width + fromX;
+    int goalTile    = toY * width + toX;
+    int startRegion = roomRegions.tileRegions[startTile];
+    int goalRegion  = roomRegions.tileRegions[goalTile];
+    if(startTile == goalTile || startRegion == NO_ROOM_REGION || goalRegion == NO_ROOM_REGION)
+        return false;
+
+    const RoomGoal* goal = GetRoomGoal(search, goalTile, goalRegion);
+
+    // The costs are the shortest walking costs, so one of the neighbours is always a step closer
+    // to the goal than the start tile.
+    int bestCost = INT_MAX;
+    int nextTile = -1;
+    for(int i = 0; i < 8; i++) {
+        if(!IsStepWalkable(fromX, fromY, NEIGHBOUR_X[i], NEIGHBOUR_Y[i])) continue;
+
+        int next = (fromY + NEIGHBOUR_Y[i]) * width + fromX + NEIGHBOUR_X[i];
+        if(roomRegions.tileRegions[next] != startRegion) continue;
+
+        int cost = GetCostToGoal(goal, goalRegion, next);
+        if(cost == ROOM_PATH_UNREACHABLE) continue;
+
+        cost += i < 4 ? STRAIGHT_STEP_COST : DIAGONAL_STEP_COST;
+        if(cost < bestCost) {
+            bestCost = cost;
+            nextTile = next;
+        }
+    }
+
+    // Rooms are only left through their entrances, crossing to the node at the other side.
+    for(int node = roomGraph.regionFirstNode[startRegion];
+        node < roomGraph.regionFirstNode[startRegion + 1]; node++) {
+        if(roomGraph.nodes[node].tile != startTile) continue;
+
+        int partnerTile = roomGraph.nodes[roomGraph.nodes[node].partner].tile;
+        int cost        = GetCostToGoal(goal, goalRegion, partnerTile);
+        if(cost == ROOM_PATH_UNREACHABLE) continue;
+
+        cost += STRAIGHT_STEP_COST;
+        if(cost < bestCost) {
+            bestCost = cost;
+            nextTile = partnerTile;
+        }
+    }
+    if(nextTile == -1) return false;
+
+    *nextPos = (Vector2){ (nextTile % width + 0.5f) * TILE_WIDTH, (nextTile / width + 0.5f) * TILE_HEIGHT };
+    return true;
+}
+
+void UnloadRoomGraphSearch(RoomGraphSearch* search) {
+    free(search->tileCosts);
+    free(search->tileStamps);
+    free(search->nodeCosts);
+    UnloadIndexHeap(&search->tileHeap);
+    UnloadIndexHeap(&search->nodeHeap);
+
+    for(int i = 0; i < ROOM_GOAL_CACHE_SIZE; i++) {
+        free(search->goals[i].tileCosts);
+        free(search->goals[i].nodeCosts);
+    }
+
+    *search = (RoomGraphSearch){ 0 };
+}
+
+void UnloadRoomGraph() {
+    free(roomGraph.nodes);
+    free(roomGraph.edges);
+    free(roomGraph.regionFirstNode);
+    free(roomGraph.regionTiles);
+    free(roomGraph.regionFirstTile);
+    free(roomGraph.tileSlots);
+    free(roomGraph.nodeTileCosts);
+
+    roomGraph = (RoomGraph){ 0 };
+
+    TraceLog(LOG_INFO, "ROOM-GRAPH.C (UnloadRoomGraph): Room graph unloaded successfully.");
+}
+
+static void BuildRoomGraphNodes() {
+    int width        = roomRegions.width;
+    int height       = roomRegions.height;
+    int numOfTiles   = width * height;
+    int numOfRegions = roomRegions.numOfRegions;
+    int* tileRegions = roomRegions.tileRegions;
+
+    // Crossings are pairs of orthogonal neighbour tiles of different regions, stored from the tile
+    // of the lowest region. At most two per tile (right and down neighbours).
+    int* lowTiles      = (int*) malloc(2 * numOfTiles * sizeof(int));
+    int* highTiles     = (int*) malloc(2 * numOfTiles * sizeof(int));
+    int* sets          = (int*) malloc(2 * numOfTiles * sizeof(int));
+    int* nextCrossings = (int*) malloc(2 * numOfTiles * sizeof(int));
+    int* firstCrossing = (int*) malloc(numOfTiles * sizeof(int));
+    roomGraph.regionFirstNode = (int*) calloc(numOfRegions + 1, sizeof(int));
+    if(lowTiles == NULL || highTiles == NULL || sets == NULL || nextCrossings == NULL ||
+       firstCrossing == NULL || roomGraph.regionFirstNode == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRoomGraphNodes, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < numOfTiles; i++) firstCrossing[i] = -1;
+
+    int numOfCrossings = 0;
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            int tile   = y * width + x;
+            int region = tileRegions[tile];
+            if(region == NO_ROOM_REGION) continue;
+
+            for(int i = 0; i < 2; i++) {
+                int otherX = x + (i == 0);
+                int otherY = y + (i == 1);
+                if(otherX >= width || otherY >= height) continue;
+
+                int otherTile   = otherY * width + otherX;
+                int otherRegion = tileRegions[otherTile];
+                if(otherRegion == NO_ROOM_REGION || otherRegion == region) continue;
+
+                int lowTile  = region < otherRegion ? tile : otherTile;
+                int crossing = numOfCrossings++;
+
+                lowTiles[crossing]      = lowTile;
+                highTiles[crossing]     = region < otherRegion ? otherTile : tile;
+                sets[crossing]          = crossing;
+                nextCrossings[crossing] = firstCrossing[lowTile];
+                firstCrossing[lowTile]  = crossing;
+            }
+        }
+    }
+
+    // Crossings between the same regions whose low tiles touch (8 neighbours) belong to the
+    // same entrance.
+    for(int crossing = 0; crossing < numOfCrossings; crossing++) {
+        int x          = lowTiles[crossing] % width;
+        int y          = lowTiles[crossing] / width;
+        int highRegion = tileRegions[highTiles[crossing]];
+
+        for(int otherY = y - 1; otherY <= y + 1; otherY++) {
+            for(int otherX = x - 1; otherX <= x + 1; otherX++) {
+                if(otherX < 0 || otherY < 0 || otherX >= width || otherY >= height) continue;
+
+                int other = firstCrossing[otherY * width + otherX];
+                for(; other != -1; other = nextCrossings[other]) {
+                    if(other == crossing || tileRegions[highTiles[other]] != highRegion) continue;
+
+                    int setA = FindCrossingSet(sets, crossing);
+                    int setB = FindCrossingSet(sets, other);
+                    if(setA != setB) sets[setA < setB ? setB : setA] = setA < setB ? setA : setB;
+                }
+            }
+        }
+    }
+
+    // Each entrance is placed at its middle crossing, in the order they were found.
+    // ? NOTE: nextCrossings is reused as the size of each set.
+    int* setSizes = nextCrossings;
+    int* setSeen  = (int*) calloc(numOfCrossings + 1, sizeof(int));
+    if(setSeen == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRoomGraphNodes, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int crossing = 0; crossing < numOfCrossings; crossing++) setSizes[crossing] = 0;
+    for(int crossing = 0; crossing < numOfCrossings; crossing++) setSizes[FindCrossingSet(sets, crossing)]++;
+
+    int numOfEntrances = 0;
+    for(int crossing = 0; crossing < numOfCrossings; crossing++) {
+        int set = FindCrossingSet(sets, crossing);
+        if(setSeen[set]++ != setSizes[set] / 2) continue;
+
+        // Entrances are compacted at the start of the crossing arrays.
+        lowTiles[numOfEntrances]  = lowTiles[crossing];
+        highTiles[numOfEntrances] = highTiles[crossing];
+        roomGraph.regionFirstNode[tileRegions[lowTiles[crossing]] + 1]++;
+        roomGraph.regionFirstNode[tileRegions[highTiles[crossing]] + 1]++;
+        numOfEntrances++;
+    }
+
+    for(int region = 0; region < numOfRegions; region++)
+        roomGraph.regionFirstNode[region + 1] += roomGraph.regionFirstNode[region];
+
+    roomGraph.numOfNodes = 2 * numOfEntrances;
+    roomGraph.nodes      = (RoomGraphNode*) malloc((roomGraph.numOfNodes + 1) * sizeof(RoomGraphNode));
+    if(roomGraph.nodes == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRoomGraphNodes, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    // Places the two nodes of each entrance in the slots of their regions.
+    int* regionNextNode = sets;
+    for(int region = 0; region < numOfRegions; region++)
+        regionNextNode[region] = roomGraph.regionFirstNode[region];
+
+    for(int entrance = 0; entrance < numOfEntrances; entrance++) {
+        int lowRegion  = tileRegions[lowTiles[entrance]];
+        int highRegion = tileRegions[highTiles[entrance]];
+        int lowNode    = regionNextNode[lowRegion]++;
+        int highNode   = regionNextNode[highRegion]++;
+
+        roomGraph.nodes[lowNode]  = (RoomGraphNode){ lowTiles[entrance], lowRegion, highNode, 0, 0, 0 };
+        roomGraph.nodes[highNode] = (RoomGraphNode){ highTiles[entrance], highRegion, lowNode, 0, 0, 0 };
+    }
+
+    free(lowTiles);
+    free(highTiles);
+    free(sets);
+    free(nextCrossings);
+    free(firstCrossing);
+    free(setSeen);
+}
+
+static int FindCrossingSet(int* sets, int crossing) {
+    while(sets[crossing] != crossing) {
+        sets[crossing] = sets[sets[crossing]];
+        crossing       = sets[crossing];
+    }
+    return crossing;
+}
+
+static void BuildRegionTiles() {
+    int numOfTiles   = roomRegions.width * roomRegions.height;
+    int numOfRegions = roomRegions.numOfRegions;
+    int* tileRegions = roomRegions.tileRegions;
+
+    roomGraph.regionFirstTile = (int*) calloc(numOfRegions + 1, sizeof(int));
+    roomGraph.regionTiles     = (int*) malloc((numOfTiles + 1) * sizeof(int));
+    roomGraph.tileSlots       = (int*) malloc(numOfTiles * sizeof(int));
+    if(roomGraph.regionFirstTile == NULL || roomGraph.regionTiles == NULL || roomGraph.tileSlots == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRegionTiles, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int tile = 0; tile < numOfTiles; tile++) {
+        if(tileRegions[tile] != NO_ROOM_REGION) roomGraph.regionFirstTile[tileRegions[tile] + 1]++;
+    }
+
+    roomGraph.maxRegionSize = 0;
+    for(int region = 0; region < numOfRegions; region++) {
+        int regionSize = roomGraph.regionFirstTile[region + 1];
+        if(regionSize > roomGraph.maxRegionSize) roomGraph.maxRegionSize = regionSize;
+        roomGraph.regionFirstTile[region + 1] += roomGraph.regionFirstTile[region];
+    }
+
+    // ? NOTE: tileSlots first keeps the next free slot of each region, then the slot of each tile.
+    int* regionNextTile = (int*) malloc((numOfRegions + 1) * sizeof(int));
+    if(regionNextTile == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-GRAPH.C (BuildRegionTiles, line: %d): Memory allocation failure.", __LINE__);
+    }
+    for(int region = 0; region < numOfRegions; region++)
+        regionNextTile[region] = roomGraph.regionFirstTile[region];
+
+    for(int tile = 0; tile < numOfTiles; tile++) {
+        int region = tileRegions[tile];
+        if(region == NO_ROOM_REGION) {
+            roomGraph.tileSlots[tile] = -1;
+            continue;
+        }
+
+        int slot                    = regionNextTile[region]++;
+        roomGraph.regionTiles[slot] = tile;
+        roomGraph.tileSlots[tile]   = slot - roomGraph.regionFirstTile[region];
+    }
+
+    free(regionNextTile);
+}
+
+static void SearchRegion(RoomGraphSearch* search, int startTile, int region) {
+    int width        = roomRegions.width;
+    int* tileRegions = roomRegions.tileRegions;
+    int* costs       = search->tileCosts;
+    IndexHeap* heap  = &search->tileHeap;
+
+    // Stamps are restarted before they overflow.
+    if(search->stamp == INT_MAX) {
+        for(int i = 0; i < width * roomRegions.height; i++) search->tileStamps[i] = 0;
+        search->stamp = 0;
+    }
+    int stamp = ++search->stamp;
+
+    costs[startTile]              = 0;
+    search->tileStamps[startTile] = stamp;
+    PushIndexHeap(heap, startTile);
+
+    while(heap->size > 0) {
+        int tile = PopIndexHeap(heap);
+        int x    = tile % width;
+        int y    = tile / width;
+
+        for(int i = 0; i < 8; i++) {
+            if(!IsStepWalkable(x, y, NEIGHBOUR_X[i], NEIGHBOUR_Y[i])) continue;
+
+            int next = (y + NEIGHBOUR_Y[i]) * width + x + NEIGHBOUR_X[i];
+            if(tileRegions[next] != region) continue;
+
+            int cost = costs[tile] + (i < 4 ? STRAIGHT_STEP_COST : DIAGONAL_STEP_COST);
+            if(search->tileStamps[next] == stamp && cost >= costs[next]) continue;
+
+            costs[next]              = cost;
+            search->tileStamps[next] = stamp;
+            PushIndexHeap(heap, next);
+        }
+    }
+}
+
+static bool IsTileReached(const RoomGraphSearch* search, int tile) {
+    return search->tileStamps[tile] == search->stamp;
+}
+
+static const RoomGoal* GetRoomGoal(RoomGraphSearch* search, int goalTile, int goalRegion) {
+    for(int i = 0; i < ROOM_GOAL_CACHE_SIZE; i++) {
+        if(search->goals[i].goalTile == goalTile) return &search->goals[i];
+    }
+
+    // Misses replace the slots in turns.
+    RoomGoal* goal   = &search->goals[search->nextGoal];
+    search->nextGoal = (search->nextGoal + 1) % ROOM_GOAL_CACHE_SIZE;
+    goal->goalTile   = goalTile;
+
+    // Costs inside the goal room.
+    SearchRegion(search, goalTile, goalRegion);
+    int firstTile = roomGraph.regionFirstTile[goalRegion];
+    int lastTile  = roomGraph.regionFirstTile[goalRegion + 1];
+    for(int slot = firstTile; slot < lastTile; slot++) {
+        int tile                           = roomGraph.regionTiles[slot];
+        goal->tileCosts[slot - firstTile] =
+            IsTileReached(search, tile) ? search->tileCosts[tile] : ROOM_PATH_UNREACHABLE;
+    }
+
+    // Dijkstra over the entrances, from the nodes of the goal room. Edges are symmetric, so the
+    // costs from the goal are also the costs to it.
+    int* nodeCosts  = search->nodeCosts;
+    IndexHeap* heap = &search->nodeHeap;
+    for(int node = 0; node < roomGraph.numOfNodes; node++) nodeCosts[node] = INT_MAX;
+
+    for(int node = roomGraph.regionFirstNode[goalRegion]; node < roomGraph.regionFirstNode[goalRegion + 1]; node++) {
+        int cost = goal->tileCosts[roomGraph.tileSlots[roomGraph.nodes[node].tile]];
+        if(cost == ROOM_PATH_UNREACHABLE) continue;
+
+        nodeCosts[node] = cost;
+        PushIndexHeap(heap, node);
+    }
+
+    while(heap->size > 0) {
+        int node                  = PopIndexHeap(heap);
+        const RoomGraphNode* from = &roomGraph.nodes[node];
+
+        for(int i = from->firstEdge; i < from->firstEdge + from->numOfEdges; i++) {
+            RoomGraphEdge edge = roomGraph.edges[i];
+            int cost           = nodeCosts[node] + edge.cost;
+            if(cost >= nodeCosts[edge.node]) continue;
+
+            nodeCosts[edge.node] = cost;
+            PushIndexHeap(heap, edge.node);
+        }
+    }
+
+    for(int node = 0; node < roomGraph.numOfNodes; node++)
+        goal->nodeCosts[node] = nodeCosts[node] == INT_MAX ? ROOM_PATH_UNREACHABLE : nodeCosts[node];
+
+    return goal;
+}
+
+static int GetCostToGoal(const RoomGoal* goal, int goalRegion, int tile) {
+    int region = roomRegions.tileRegions[tile];
+    int slot   = roomGraph.tileSlots[tile];
+    int best   = ROOM_PATH_UNREACHABLE;
+
+    if(region == goalRegion && goal->tileCosts[slot] != ROOM_PATH_UNREACHABLE) best = goal->tileCosts[slot];
+
+    for(int node = roomGraph.regionFirstNode[region]; node < roomGraph.regionFirstNode[region + 1]; node++) {
+        int toNode = roomGraph.nodeTileCosts[roomGraph.nodes[node].firstTileCost + slot];
+        if(toNode == ROOM_PATH_UNREACHABLE || goal->nodeCosts[node] == ROOM_PATH_UNREACHABLE) continue;
+
+        int cost = toNode + goal->nodeCosts[node];
+        if(best == ROOM_PATH_UNREACHABLE || cost < best) best = cost;
+    }
+
+    return best;
+}
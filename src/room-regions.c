@@ -0,0 +1,176 @@
+/***********************************************************************************************
+ *
+ **   Provides functionality for the regions of the rooms of the dungeon and the visibility
+ **   between them.
+ *
+ *    @authors Marcus Vinicius Santos Lages and Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <math.h>, <stdlib.h>, room-regions.h
+ *
+ ***********************************************************************************************/
+
+#include "../include/room-regions.h"
+#include <math.h>
+#include <stdlib.h>
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+RoomRegions roomRegions;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Marks the regions a and b as visible from each other.
+ */
+static void SetRegionsVisible(int regionA, int regionB);
+
+/**
+ * Checks if the regions a and b were marked as visible from each other.
+ */
+static bool IsRegionPairVisible(int regionA, int regionB);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void BuildRoomRegions() {
+    int width      = collisionGrid.width;
+    int height     = collisionGrid.height;
+    int numOfTiles = width * height;
+    int numOfRooms = 0;
+    for(RoomNode* cursor = rooms; cursor != NULL; cursor = cursor->next) numOfRooms++;
+
+    roomRegions.width        = width;
+    roomRegions.height       = height;
+    roomRegions.numOfRegions = numOfRooms;
+    roomRegions.tileRegions  = (int*) malloc(numOfTiles * sizeof(int));
+
+    int* queue = (int*) malloc(numOfTiles * sizeof(int));
+    if(roomRegions.tileRegions == NULL || queue == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-REGIONS.C (BuildRoomRegions, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    int* tileRegions = roomRegions.tileRegions;
+    for(int i = 0; i < numOfTiles; i++) tileRegions[i] = NO_ROOM_REGION;
+
+    // The spawn tiles of every room start the search with the region of their room.
+    int head = 0, tail = 0;
+    int region = 0;
+    for(RoomNode* cursor = rooms; cursor != NULL; cursor = cursor->next, region++) {
+        PositionArray* positionArray = &cursor->positionArray;
+        for(int i = 0; i < positionArray->currSize; i++) {
+            int x = positionArray->positions[i].x;
+            int y = positionArray->positions[i].y;
+            if(IsSolid(x, y) || tileRegions[y * width + x] != NO_ROOM_REGION) continue;
+
+            tileRegions[y * width + x] = region;
+            queue[tail++]              = y * width + x;
+        }
+    }
+
+    const int offsetsX[4] = { 1, -1, 0, 0 };
+    const int offsetsY[4] = { 0, 0, 1, -1 };
+
+    while(head < tail) {
+        int tile = queue[head++];
+        int x    = tile % width;
+        int y    = tile / width;
+
+        for(int i = 0; i < 4; i++) {
+            int nextX = x + offsetsX[i];
+            int nextY = y + offsetsY[i];
+            if(IsSolid(nextX, nextY) || tileRegions[nextY * width + nextX] != NO_ROOM_REGION)
+                continue;
+
+            tileRegions[nextY * width + nextX] = tileRegions[tile];
+            queue[tail++]                      = nextY * width + nextX;
+        }
+    }
+
+    free(queue);
+
+    TraceLog(LOG_INFO, "ROOM-REGIONS.C (BuildRoomRegions): Regions of %d rooms built.", numOfRooms);
+}
+
+void BuildRoomVisibility(int radius) {
+    int width        = roomRegions.width;
+    int height       = roomRegions.height;
+    int numOfRegions = roomRegions.numOfRegions;
+    int numOfBits    = numOfRegions * numOfRegions;
+
+    roomRegions.visibleBits = (unsigned char*) calloc((numOfBits + 7) / 8, sizeof(unsigned char));
+    if(roomRegions.visibleBits == NULL) {
+        TraceLog(LOG_FATAL, "ROOM-REGIONS.C (BuildRoomVisibility, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    int* tileRegions = roomRegions.tileRegions;
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            int regionA = tileRegions[y * width + x];
+            if(regionA == NO_ROOM_REGION) continue;
+
+            // Same shadowcast the player runs, so the table never hides a tile its view reveals.
+            UpdateFieldOfView((Vector2){ (x + 0.5f) * TILE_WIDTH, (y + 0.5f) * TILE_HEIGHT }, radius);
+
+            for(int otherY = y - radius; otherY <= y + radius; otherY++) {
+                for(int otherX = x - radius; otherX <= x + radius; otherX++) {
+                    if(otherX < 0 || otherY < 0 || otherX >= width || otherY >= height) continue;
+
+                    int regionB = tileRegions[otherY * width + otherX];
+                    if(regionB == NO_ROOM_REGION || IsRegionPairVisible(regionA, regionB)) continue;
+
+                    Vector2 otherCenter = { (otherX + 0.5f) * TILE_WIDTH, (otherY + 0.5f) * TILE_HEIGHT };
+                    if(IsPosVisible(otherCenter)) SetRegionsVisible(regionA, regionB);
+                }
+            }
+        }
+    }
+
+    TraceLog(LOG_INFO, "ROOM-REGIONS.C (BuildRoomVisibility): Visibility between %d rooms computed.", numOfRegions);
+}
+
+int GetRegion(Vector2 pos) {
+    if(roomRegions.tileRegions == NULL) return NO_ROOM_REGION;
+
+    int x = (int) floorf(pos.x / TILE_WIDTH);
+    int y = (int) floorf(pos.y / TILE_HEIGHT);
+    if(x < 0 || y < 0 || x >= roomRegions.width || y >= roomRegions.height) return NO_ROOM_REGION;
+
+    return roomRegions.tileRegions[y * roomRegions.width + x];
+}
+
+bool AreRegionsVisible(Vector2 from, Vector2 to) {
+    if(roomRegions.visibleBits == NULL) return true;
+
+    int regionA = GetRegion(from);
+    int regionB = GetRegion(to);
+    if(regionA == NO_ROOM_REGION || regionB == NO_ROOM_REGION) return true;
+
+    return IsRegionPairVisible(regionA, regionB);
+}
+
+void UnloadRoomRegions() {
+    free(roomRegions.tileRegions);
+    free(roomRegions.visibleBits);
+    roomRegions.tileRegions  = NULL;
+    roomRegions.visibleBits  = NULL;
+    roomRegions.numOfRegions = 0;
+    roomRegions.width        = 0;
+    roomRegions.height       = 0;
+
+    TraceLog(LOG_INFO, "ROOM-REGIONS.C (UnloadRoomRegions): Room regions unloaded successfully.");
+}
+
+static void SetRegionsVisible(int regionA, int regionB) {
+    int bitAB = regionA * roomRegions.numOfRegions + regionB;
+    int bitBA = regionB * roomRegions.numOfRegions + regionA;
+    roomRegions.visibleBits[bitAB / 8] |= 1 << (bitAB % 8);
+    roomRegions.visibleBits[bitBA / 8] |= 1 << (bitBA % 8);
+}
+
+static bool IsRegionPairVisible(int regionA, int regionB) {
+    int bit = regionA * roomRegions.numOfRegions + regionB;
+    return (roomRegions.visibleBits[bit / 8] >> (bit % 8)) & 1;
+}
@@ -16,6 +16,10 @@
 //* GLOBAL VARIABLES
 
 RoomNode* rooms;
+RoomRegistry roomRegistry;
+
+/** Last room of the list, so new rooms are appended without walking it. */
+static RoomNode* lastRoom;
 
 //* ------------------------------------------
 //* FUNCTION PROTOTYPES
@@ -34,6 +38,30 @@ static PositionArray CreatePositionArray(int arraySize);
  */
 static void UnloadPositionArray(PositionArray* positionArray);
 
+/**
+ * Inserts a room in the roomRegistry, growing it when half full.
+ *
+ * @param room  The room to register.
+ *
+ * ! @note Reallocates the arrays of the roomRegistry when it grows.
+ */
+static void RegisterRoom(RoomNode* room);
+
+/**
+ * Reallocates the roomRegistry with a new capacity and inserts the registered rooms again.
+ *
+ * @param capacity  The new number of slots (power of two).
+ */
+static void ResizeRoomRegistry(int capacity);
+
+/**
+ * Returns the first slot to probe for a room number in the roomRegistry.
+ *
+ * @param roomNumber    The room number.
+ * @returns             The slot index.
+ */
+static int GetRoomSlot(int roomNumber);
+
 //* ------------------------------------------
 //* FUNCTION IMPLEMENTATIONS
 
@@ -56,30 +84,29 @@ void AddPosition(PositionArray* positionArray, Vector2 position) {
         return;
     }
 
-    if(positionArray->currSize == positionArray->size) {
-        TraceLog(LOG_WARNING, "SPAWNER.C (AddPosition, line: %d): Inserting into a full array.", __LINE__);
-        return;
-    }
-
     if(positionArray->positions == NULL) {
         TraceLog(LOG_WARNING, "SPAWNER.C (AddPosition, line: %d): NULL array of positions was found.", __LINE__);
         return;
     }
 
+    if(positionArray->currSize == positionArray->size) {
+        positionArray->size *= 2;
+        positionArray->positions =
+            (Vector2*) realloc(positionArray->positions, positionArray->size * sizeof(Vector2));
+
+        if(positionArray->positions == NULL) {
+            TraceLog(LOG_FATAL, "SPAWNER.C (AddPosition, line: %d): Memory allocation failure.", __LINE__);
+        }
+    }
+
     positionArray->currSize++;
     int idx                       = positionArray->currSize - 1;
     positionArray->positions[idx] = position;
 }
 
 void AddPositionToRoom(int roomNumber, Vector2 position) {
-    RoomNode* cursor = rooms;
-    while(cursor != NULL) {
-        if(cursor->roomNumber == roomNumber) {
-            AddPosition(&cursor->positionArray, position);
-            break;
-        }
-        cursor = cursor->next;
-    }
+    RoomNode* room = FindRoom(roomNumber);
+    if(room != NULL) AddPosition(&room->positionArray, position);
 }
 
 static void UnloadPositionArray(PositionArray* positionArray) {
@@ -127,11 +154,24 @@ RoomNode* CreateRoomList(Vector2 initPos, int roomNumber, RoomSize roomSize) {
 void AddRoomNode(Vector2 position, int roomNumber, RoomSize roomSize) {
     RoomNode* room = CreateRoomList(position, roomNumber, roomSize);
 
-    RoomNode* cursor = rooms;
-    while(cursor->next != NULL) {
-        cursor = cursor->next;
+    if(rooms == NULL) {
+        rooms = room;
+    } else {
+        lastRoom->next = room;
+    }
+    lastRoom = room;
+
+    RegisterRoom(room);
+}
+
+RoomNode* FindRoom(int roomNumber) {
+    if(roomRegistry.size == 0) return NULL;
+
+    int mask = roomRegistry.capacity - 1;
+    for(int slot = GetRoomSlot(roomNumber); roomRegistry.slots[slot] != NULL; slot = (slot + 1) & mask) {
+        if(roomRegistry.roomNumbers[slot] == roomNumber) return roomRegistry.slots[slot];
     }
-    cursor->next = room;
+    return NULL;
 }
 
 void UnloadRooms() {
@@ -148,16 +188,55 @@ void UnloadRooms() {
         free(temp);
         temp = NULL;
     }
+    lastRoom = NULL;
+
+    free(roomRegistry.roomNumbers);
+    free(roomRegistry.slots);
+    roomRegistry = (RoomRegistry){ 0 };
     TraceLog(LOG_INFO, "SPAWNER.C (UnloadRooms): All rooms have been unloaded.");
 }
 
 bool CheckRoomExists(int roomNumber) {
-    RoomNode* cursor = rooms;
-    while(cursor != NULL) {
-        if(cursor->roomNumber == roomNumber) {
-            return true;
-        }
-        cursor = cursor->next;
+    return FindRoom(roomNumber) != NULL;
+}
+
+static void RegisterRoom(RoomNode* room) {
+    if(2 * (roomRegistry.size + 1) > roomRegistry.capacity) {
+        ResizeRoomRegistry(
+            roomRegistry.capacity > 0 ? 2 * roomRegistry.capacity : ROOM_REGISTRY_INITIAL_CAPACITY);
     }
-    return false;
+
+    int mask = roomRegistry.capacity - 1;
+    int slot = GetRoomSlot(room->roomNumber);
+    while(roomRegistry.slots[slot] != NULL) slot = (slot + 1) & mask;
+
+    roomRegistry.roomNumbers[slot] = room->roomNumber;
+    roomRegistry.slots[slot]       = room;
+    roomRegistry.size++;
+}
+
+static void ResizeRoomRegistry(int capacity) {
+    int oldCapacity     = roomRegistry.capacity;
+    int* oldRoomNumbers = roomRegistry.roomNumbers;
+    RoomNode** oldSlots = roomRegistry.slots;
+
+    roomRegistry.capacity    = capacity;
+    roomRegistry.size        = 0;
+    roomRegistry.roomNumbers = (int*) malloc(capacity * sizeof(int));
+    roomRegistry.slots       = (RoomNode**) calloc(capacity, sizeof(RoomNode*));
+
+    if(roomRegistry.roomNumbers == NULL || roomRegistry.slots == NULL) {
+        TraceLog(LOG_FATAL, "SPAWNER.C (ResizeRoomRegistry, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < oldCapacity; i++) {
+        if(oldSlots[i] != NULL) RegisterRoom(oldSlots[i]);
+    }
+
+    free(oldRoomNumbers);
+    free(oldSlots);
+}
+
+static int GetRoomSlot(int roomNumber) {
+    return (int) (((unsigned int) roomNumber * 2654435761u) & (unsigned int) (roomRegistry.capacity - 1));
 }
\ No newline at end of file
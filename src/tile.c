@@ -5,11 +5,11 @@
  *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
  *    @version 0.3
  *
- *    @include <stdlib.h>, tile.h, collision.h, spawner.h, texture.h
+ *    @include <stdlib.h>, tile.h, collision-grid.h, spawner.h, texture.h
  *
  **********************************************************************************************/
 #include "../include/tile.h"
-#include "../include/collision.h"
+#include "../include/collision-grid.h"
 #include "../include/spawner.h"
 #include "../include/texture.h"
 #include <stdlib.h>
@@ -85,6 +85,9 @@ tmx_map* TmxMapFrameBufStartup(RenderTexture2D* framebuffer, char* mapFileName)
     *framebuffer = LoadRenderTexture(
         mapTmx->width * mapTmx->tile_width, mapTmx->height * mapTmx->tile_height);
 
+    // Start the collision grid with the size of the tilemap
+    CreateCollisionGrid(mapTmx->width, mapTmx->height);
+
 
     TraceLog(LOG_INFO, "TILE.C (TmxMapFrameBufStartup): Tmx map loaded.");
 
@@ -125,6 +128,11 @@ void TmxMapFrameBufRender(RenderTexture2D* framebuffer, tmx_map* map) {
 
     EndTextureMode();
 
+    // All the solid tiles of every layer are known, so they can be merged into rectangles
+    // and the distance of every tile to the closest wall can be computed.
+    MergeSolidTiles();
+    ComputeWallDistances();
+
     TraceLog(LOG_INFO, "TILE.C (TmxMapFrameBufRender): Texture rendered from tmx map.");
 }
 
@@ -149,13 +157,8 @@ void DrawTmxLayer(tmx_map* map, tmx_layer* layer) {
                     if(collisionProp != NULL) {
                         bool isCollidable = collisionProp->value.boolean;
 
-                        // If the tile is collidable adds it to the collidable tiles collision list
-                        if(isCollidable) {
-                            if(collidableTiles == NULL)
-                                collidableTiles = CreateCollisionList(col, row, 0);
-                            else
-                                AddCollisionNode(collidableTiles, col, row, 0);
-                        }
+                        // If the tile is collidable marks it as solid in the collision grid
+                        if(isCollidable) SetSolidTile(col, row);
                     }
 
                     // Gets the room properties from the tile
@@ -169,15 +172,12 @@ void DrawTmxLayer(tmx_map* map, tmx_layer* layer) {
                         int roomNumber    = roomNumberProp->value.integer;
                         RoomSize roomSize = roomSizeProp->value.integer;
 
-                        if(rooms == NULL) {
-                            rooms = CreateRoomList((Vector2){ col, row }, roomNumber, roomSize);
+                        RoomNode* room = FindRoom(roomNumber);
+                        if(room == NULL) {
+                            AddRoomNode((Vector2){ col, row }, roomNumber, roomSize);
                         } else {
-                            if(!CheckRoomExists(roomNumber)) {
-                                AddRoomNode((Vector2){ col, row }, roomNumber, roomSize);
-                            } else {
-                                // This room already exists so we add a position to it.
-                                AddPositionToRoom(roomNumber, (Vector2){ col, row });
-                            }
+                            // This room already exists so we add a position to it.
+                            AddPosition(&room->positionArray, (Vector2){ col, row });
                         }
                     }
 
@@ -188,7 +188,7 @@ void DrawTmxLayer(tmx_map* map, tmx_layer* layer) {
         }
     }
 
-    TraceLog(LOG_INFO, "TILE.C (DrawTmxLayer): Collidable tiles list created successfully.");
+    TraceLog(LOG_INFO, "TILE.C (DrawTmxLayer): Collidable tiles added to the collision grid successfully.");
     TraceLog(
         LOG_INFO, "TILE.C (DrawTmxLayer): Layer (%s) rendered successfully.",
         layer->name);
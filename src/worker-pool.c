@@ -0,0 +1,170 @@
+/**********************************************************************************************
+ *
+ **   worker-pool.c is responsible for implementing the pool of threads that run jobs over
+ **   ranges of items in parallel.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdint.h>, <stdlib.h>, <unistd.h> (non Windows builds only), raylib.h,
+ *             worker-pool.h
+ *
+ **********************************************************************************************/
+
+#include "../include/worker-pool.h"
+#include "raylib.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+WorkerPool workerPool;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Gets the number of cores online, at least 1.
+ *
+ * ? @note Uses the winpthreads count on Windows, where sysconf has no core count.
+ */
+static int GetNumOfCores();
+
+/**
+ * Loop of each thread of the pool, waiting for jobs and running their chunks until stopped.
+ *
+ * @param arg   Index of the worker of the thread (intptr_t), from 1 on.
+ */
+static void* RunWorker(void* arg);
+
+/**
+ * Takes chunks of the current job and runs them until no item is left.
+ *
+ * ! @attention The mutex of the pool must be locked, it is unlocked while the chunks run.
+ *
+ * @param worker    Index of the worker running the chunks.
+ */
+static void RunJobChunks(int worker);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+void CreateWorkerPool() {
+    // The main thread runs jobs too, so it takes one of the cores.
+    int numOfThreads = GetNumOfCores() - 1;
+    if(numOfThreads > WORKER_POOL_MAX_THREADS) numOfThreads = WORKER_POOL_MAX_THREADS;
+
+    workerPool = (WorkerPool){ 0 };
+    pthread_mutex_init(&workerPool.mutex, NULL);
+    pthread_cond_init(&workerPool.workReady, NULL);
+    pthread_cond_init(&workerPool.workDone, NULL);
+
+    workerPool.threads = (pthread_t*) malloc(numOfThreads * sizeof(pthread_t));
+    if(workerPool.threads == NULL && numOfThreads > 0) {
+        TraceLog(LOG_FATAL, "WORKER-POOL.C (CreateWorkerPool, line: %d): Memory allocation failure.", __LINE__);
+    }
+
+    for(int i = 0; i < numOfThreads; i++) {
+        if(pthread_create(&workerPool.threads[i], NULL, RunWorker, (void*) (intptr_t) (i + 1)) != 0) {
+            TraceLog(LOG_WARNING, "WORKER-POOL.C (CreateWorkerPool, line: %d): Could not create thread %d.", __LINE__, i);
+            break;
+        }
+        workerPool.numOfThreads++;
+    }
+
+    TraceLog(LOG_INFO, "WORKER-POOL.C (CreateWorkerPool): Worker pool started with %d threads.", workerPool.numOfThreads);
+}
+
+void RunWorkerPool(WorkerJob job, void* data, int numOfItems) {
+    if(workerPool.numOfThreads == 0 || numOfItems <= WORKER_POOL_CHUNK_SIZE) {
+        if(numOfItems > 0) job(0, numOfItems, 0, data);
+        return;
+    }
+
+    pthread_mutex_lock(&workerPool.mutex);
+    workerPool.job        = job;
+    workerPool.data       = data;
+    workerPool.numOfItems = numOfItems;
+    workerPool.nextItem   = 0;
+    workerPool.generation++;
+    pthread_cond_broadcast(&workerPool.workReady);
+
+    // The main thread runs chunks as well, then waits for the threads still running theirs.
+    RunJobChunks(0);
+    while(workerPool.numOfBusy > 0) pthread_cond_wait(&workerPool.workDone, &workerPool.mutex);
+    pthread_mutex_unlock(&workerPool.mutex);
+}
+
+int GetNumOfWorkers() {
+    return workerPool.numOfThreads + 1;
+}
+
+void UnloadWorkerPool() {
+    pthread_mutex_lock(&workerPool.mutex);
+    workerPool.isStopping = true;
+    pthread_cond_broadcast(&workerPool.workReady);
+    pthread_mutex_unlock(&workerPool.mutex);
+
+    for(int i = 0; i < workerPool.numOfThreads; i++) pthread_join(workerPool.threads[i], NULL);
+
+    free(workerPool.threads);
+    pthread_cond_destroy(&workerPool.workDone);
+    pthread_cond_destroy(&workerPool.workReady);
+    pthread_mutex_destroy(&workerPool.mutex);
+    workerPool = (WorkerPool){ 0 };
+
+    TraceLog(LOG_INFO, "WORKER-POOL.C (UnloadWorkerPool): Worker pool stopped successfully.");
+}
+
+static int GetNumOfCores() {
+#if defined(_WIN32)
+    int numOfCores = pthread_num_processors_np();
+#else
+    int numOfCores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return numOfCores > 0 ? numOfCores : 1;
+}
+
+static void* RunWorker(void* arg) {
+    int worker              = (int) (intptr_t) arg;
+    unsigned int generation = 0;
+
+    pthread_mutex_lock(&workerPool.mutex);
+    while(true) {
+        while(!workerPool.isStopping && workerPool.generation == generation) {
+            pthread_cond_wait(&workerPool.workReady, &workerPool.mutex);
+        }
+        if(workerPool.isStopping) break;
+
+        // Threads waking up after all the items were taken just find nothing to run.
+        generation = workerPool.generation;
+        workerPool.numOfBusy++;
+        RunJobChunks(worker);
+        workerPool.numOfBusy--;
+
+        if(workerPool.numOfBusy == 0) pthread_cond_signal(&workerPool.workDone);
+    }
+    pthread_mutex_unlock(&workerPool.mutex);
+    return NULL;
+}
+
+static void RunJobChunks(int worker) {
+    while(workerPool.nextItem < workerPool.numOfItems) {
+        int first = workerPool.nextItem;
+        int last  = first + WORKER_POOL_CHUNK_SIZE;
+        if(last > workerPool.numOfItems) last = workerPool.numOfItems;
+
+        workerPool.nextItem = last;
+        WorkerJob job       = workerPool.job;
+        void* data          = workerPool.data;
+
+        pthread_mutex_unlock(&workerPool.mutex);
+        job(first, last, worker, data);
+        pthread_mutex_lock(&workerPool.mutex);
+    }
+}
@@ -0,0 +1,211 @@
+/**********************************************************************************************
+ *
+ **   collision-test.c is a differential test of RayRectBatchCollision against the scalar
+ **   RayRectCollision it batches.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdio.h>, collision.h
+ *
+ *    ? @note Built twice by the test target of the Makefile: once as is (SSE2 path on x86-64)
+ *            and once with __SSE2__ undefined (scalar fallback), so both paths are compared.
+ *
+ **********************************************************************************************/
+
+#include "../include/collision.h"
+#include <stdio.h>
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Number of random batches tested. */
+#define NUM_OF_RANDOM_CASES 20000
+
+/** Side of the square of the world where the random rays and rectangles are placed. */
+#define TEST_WORLD_SIZE 256
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** State of the pseudo random generator, fixed so failures can be reproduced. */
+static unsigned int randomState = 12345u;
+
+/** Number of mismatches found. */
+static int numOfFailures = 0;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Returns a pseudo random integer between min and max (inclusive).
+ */
+static int RandomInt(int min, int max);
+
+/**
+ * Returns a pseudo random float between min and max. Half of the values are snapped to
+ * multiples of 8 so edges and hit times tie often, like tiles do in the game.
+ */
+static float RandomCoord(float min, float max);
+
+/**
+ * Checks if two floats are the same value, NaN included.
+ */
+static bool IsSameFloat(float a, float b);
+
+/**
+ * Compares RayRectBatchCollision against RayRectCollision for a ray and a batch, printing any
+ * mismatch of hit, hit time, contact point, normal or earliest index.
+ *
+ * @param name  Name of the case, printed on failures
+ * @param ray   Ray to test
+ * @param batch Batch of rectangles to test
+ */
+static void CompareBatch(const char* name, Ray2D ray, const RectangleBatch* batch);
+
+/**
+ * Fills a batch with random rectangles.
+ */
+static void FillRandomBatch(RectangleBatch* batch, int size);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+int main(void) {
+    RectangleBatch batch;
+
+    // Random rays and rectangles.
+    for(int i = 0; i < NUM_OF_RANDOM_CASES; i++) {
+        FillRandomBatch(&batch, RandomInt(1, RECTANGLE_BATCH_CAPACITY));
+        Ray2D ray = { { RandomCoord(0, TEST_WORLD_SIZE), RandomCoord(0, TEST_WORLD_SIZE) },
+                      { RandomCoord(-TEST_WORLD_SIZE, TEST_WORLD_SIZE),
+                        RandomCoord(-TEST_WORLD_SIZE, TEST_WORLD_SIZE) } };
+        CompareBatch("random", ray, &batch);
+    }
+
+    // Axis-parallel rays, including rays running along the edges of the rectangles.
+    for(int i = 0; i < NUM_OF_RANDOM_CASES / 4; i++) {
+        FillRandomBatch(&batch, RandomInt(1, RECTANGLE_BATCH_CAPACITY));
+        Vector2 origin = { RandomCoord(0, TEST_WORLD_SIZE), RandomCoord(0, TEST_WORLD_SIZE) };
+        float length   = RandomCoord(-TEST_WORLD_SIZE, TEST_WORLD_SIZE);
+
+        CompareBatch("horizontal", (Ray2D){ origin, { length, 0 } }, &batch);
+        CompareBatch("vertical", (Ray2D){ origin, { 0, length } }, &batch);
+        CompareBatch("still", (Ray2D){ origin, { 0, 0 } }, &batch);
+    }
+
+    // Ray origins inside one of the rectangles.
+    for(int i = 0; i < NUM_OF_RANDOM_CASES / 4; i++) {
+        FillRandomBatch(&batch, RandomInt(1, RECTANGLE_BATCH_CAPACITY));
+        int inside     = RandomInt(0, batch.size - 1);
+        Vector2 origin = { batch.x[inside] + batch.width[inside] / 2,
+                           batch.y[inside] + batch.height[inside] / 2 };
+        Ray2D ray      = { origin, { RandomCoord(-TEST_WORLD_SIZE, TEST_WORLD_SIZE),
+                                     RandomCoord(-TEST_WORLD_SIZE, TEST_WORLD_SIZE) } };
+        CompareBatch("inside", ray, &batch);
+    }
+
+    // Tied hit times: copies of the same rectangle and rectangles sharing the edge that is hit.
+    for(int i = 0; i < NUM_OF_RANDOM_CASES / 4; i++) {
+        FillRandomBatch(&batch, RandomInt(2, RECTANGLE_BATCH_CAPACITY));
+        int original = RandomInt(0, batch.size - 1);
+        for(int j = 0; j < batch.size; j++) {
+            if(RandomInt(0, 1) == 0) continue;
+            batch.x[j]      = batch.x[original];
+            batch.y[j]      = batch.y[original];
+            batch.height[j] = batch.height[original];
+            batch.width[j]  = RandomInt(0, 1) == 0 ? batch.width[original] : RandomCoord(8, 64);
+        }
+
+        Vector2 origin = { batch.x[original] - RandomCoord(1, 64),
+                           batch.y[original] + batch.height[original] / 2 };
+        Ray2D ray      = { origin, { RandomCoord(64, 128), RandomCoord(-8, 8) } };
+        CompareBatch("tied", ray, &batch);
+    }
+
+    if(numOfFailures > 0) {
+        printf("collision-test: %d mismatches found.\n", numOfFailures);
+        return 1;
+    }
+
+    printf("collision-test: all cases passed.\n");
+    return 0;
+}
+
+static int RandomInt(int min, int max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (int) ((randomState >> 8) % (unsigned int) (max - min + 1));
+}
+
+static float RandomCoord(float min, float max) {
+    randomState  = randomState * 1664525u + 1013904223u;
+    float amount = (randomState >> 8) / (float) (1u << 24);
+    float coord  = min + (max - min) * amount;
+    if(RandomInt(0, 1) == 0) coord = (int) (coord / 8) * 8.0f;
+    return coord;
+}
+
+static bool IsSameFloat(float a, float b) {
+    return a == b || (a != a && b != b);
+}
+
+static void CompareBatch(const char* name, Ray2D ray, const RectangleBatch* batch) {
+    RayCollision2D collisions[RECTANGLE_BATCH_CAPACITY];
+    int hitIndex            = -2;
+    RayCollision2D earliest = RayRectBatchCollision(ray, batch, &hitIndex, collisions);
+
+    // Reference: the earliest collision between the origin and direction point, first index on ties.
+    RayCollision2D expectedEarliest;
+    expectedEarliest.hit     = false;
+    expectedEarliest.timeHit = 0;
+    int expectedIndex        = -1;
+
+    for(int i = 0; i < batch->size; i++) {
+        Rectangle rec =
+            (Rectangle){ batch->x[i], batch->y[i], batch->width[i], batch->height[i] };
+        RayCollision2D expected = RayRectCollision(ray, rec);
+        RayCollision2D actual   = collisions[i];
+
+        bool isMatch = expected.hit == actual.hit;
+        if(isMatch && expected.hit) {
+            isMatch = IsSameFloat(expected.timeHit, actual.timeHit) &&
+                IsSameFloat(expected.contactPoint.x, actual.contactPoint.x) &&
+                IsSameFloat(expected.contactPoint.y, actual.contactPoint.y) &&
+                expected.normalVector.x == actual.normalVector.x &&
+                expected.normalVector.y == actual.normalVector.y;
+        }
+
+        if(!isMatch) {
+            numOfFailures++;
+            printf("%s: ray (%g, %g) -> (%g, %g), rectangle %d (%g, %g, %g, %g): "
+                   "expected hit %d time %g normal (%g, %g), got hit %d time %g normal (%g, %g)\n",
+                   name, ray.origin.x, ray.origin.y, ray.direction.x, ray.direction.y, i, rec.x,
+                   rec.y, rec.width, rec.height, expected.hit, expected.timeHit,
+                   expected.normalVector.x, expected.normalVector.y, actual.hit, actual.timeHit,
+                   actual.normalVector.x, actual.normalVector.y);
+        }
+
+        if(expected.hit && expected.timeHit >= 0 && expected.timeHit <= 1 &&
+           (!expectedEarliest.hit || expected.timeHit < expectedEarliest.timeHit)) {
+            expectedEarliest = expected;
+            expectedIndex    = i;
+        }
+    }
+
+    if(hitIndex != expectedIndex || earliest.hit != expectedEarliest.hit ||
+       (earliest.hit && !IsSameFloat(earliest.timeHit, expectedEarliest.timeHit))) {
+        numOfFailures++;
+        printf("%s: ray (%g, %g) -> (%g, %g): expected earliest index %d, got %d\n", name,
+               ray.origin.x, ray.origin.y, ray.direction.x, ray.direction.y, expectedIndex,
+               hitIndex);
+    }
+}
+
+static void FillRandomBatch(RectangleBatch* batch, int size) {
+    batch->size = 0;
+    for(int i = 0; i < size; i++) {
+        Rectangle rec = { RandomCoord(0, TEST_WORLD_SIZE), RandomCoord(0, TEST_WORLD_SIZE),
+                          RandomCoord(8, 64), RandomCoord(8, 64) };
+        AddRectangleToBatch(batch, rec);
+    }
+}
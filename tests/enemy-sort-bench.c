@@ -0,0 +1,350 @@
+/**********************************************************************************************
+ *
+ **   enemy-sort-bench.c is a headless benchmark of the neighbour queries of the enemy update
+ **   with the pool in spawn order, in random order and sorted by SortEnemies.
+ *
+ *    @authors Marcus Vinicius Santos Lages, Samarjit Bhogal
+ *    @version 0.3
+ *
+ *    @include <stdio.h>, <stdlib.h>, <string.h>, <time.h>, enemy-hash.h, enemy-pool.h,
+ *             <linux/perf_event.h>, <sys/ioctl.h>, <sys/syscall.h>, <unistd.h> (Linux only)
+ *
+ *    ? @note Links the pool storage (enemy-pool.c) and the spatial hash (enemy-hash.c) of the
+ *            game against a pool filled here, so no window, textures or map are needed. The
+ *            pool is shuffled with PermuteEnemies and sorted with SortEnemies, the same code
+ *            the game runs. Each frame runs the same steps as GetEnemyNeighbours for every
+ *            enemy, in slot order, then reads the neighbours found in the snapshot.
+ *    ? @note The cache misses of each order are read with the counters `perf stat` uses
+ *            (perf_event_open), around the timed frames only. They are printed as n/a when
+ *            the kernel or the CPU do not expose them (non Linux builds, virtual machines).
+ *
+ **********************************************************************************************/
+
+#include "../include/enemy-hash.h"
+#include "../include/enemy-pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//* ------------------------------------------
+//* DEFINITIONS
+
+/** Side of the square map in tiles. */
+#define BENCH_MAP_SIZE 512
+
+/** Side of the square rooms the enemies are spawned in, in tiles. */
+#define BENCH_ROOM_SIZE 16
+
+/** Number of enemies spawned in each room, all of the same type. */
+#define BENCH_ROOM_ENEMIES 8
+
+/** Number of frames measured for each order. */
+#define BENCH_NUM_OF_FRAMES 20
+
+/** Number of cache counters read around the frames. */
+#define BENCH_NUM_OF_COUNTERS 2
+
+//* ------------------------------------------
+//* STRUCTURES
+
+/**
+ * Cost of the frames run over the pool in one order.
+ *
+ * @param time      Nanoseconds per enemy per frame.
+ * @param misses    Misses of each cache counter per enemy per frame (-1 if not available).
+ */
+typedef struct BenchResult {
+    double time;
+    double misses[BENCH_NUM_OF_COUNTERS];
+} BenchResult;
+
+//* ------------------------------------------
+//* GLOBAL VARIABLES
+
+/** The pool read by the spatial hash and sorted by the pool storage. */
+EnemyPool enemies;
+
+/** Names of the cache counters, as `perf stat` lists them. */
+static const char* counterNames[BENCH_NUM_OF_COUNTERS] = { "cache-misses", "L1-dcache-load-misses" };
+
+/** File descriptors of the cache counters (-1 if not available). */
+static int counters[BENCH_NUM_OF_COUNTERS] = { -1, -1 };
+
+/** State of the pseudo random generator, fixed so the runs can be compared. */
+static unsigned int randomState = 12345u;
+
+/** Sum of the values read, printed so the reads are not optimised away. */
+static long checksum = 0;
+
+//* ------------------------------------------
+//* FUNCTION PROTOTYPES
+
+/**
+ * Returns a pseudo random integer between min and max (inclusive).
+ */
+static int RandomInt(int min, int max);
+
+/**
+ * Fills the pool with enemies spawned room by room, each one added at the end of the partition
+ * of its type, like the rooms reached one at a time.
+ */
+static void SpawnEnemies(int numOfEnemies);
+
+/**
+ * Shuffles each partition of the pool with PermuteEnemies, the order of a pool after a long
+ * time of enemies moving around, and rebuilds the spatial hash.
+ */
+static void ShuffleEnemies();
+
+/**
+ * Runs BENCH_NUM_OF_FRAMES frames of neighbour queries over the whole pool.
+ *
+ * @returns The time and cache misses per enemy per frame.
+ */
+static BenchResult RunNeighbourQueries();
+
+/**
+ * Opens the cache counters of this process, the ones that fail stay at -1.
+ */
+static void OpenCacheCounters();
+
+/**
+ * Resets and starts (isEnabled true) or stops (isEnabled false) the cache counters.
+ */
+static void EnableCacheCounters(bool isEnabled);
+
+/**
+ * Returns the value of a cache counter, or -1 if it is not available.
+ */
+static long ReadCacheCounter(int counter);
+
+/**
+ * Prints a line of the results.
+ */
+static void PrintResult(int numOfEnemies, const char* order, BenchResult result);
+
+/**
+ * Returns the nanoseconds elapsed between two times.
+ */
+static double GetElapsedNanoseconds(struct timespec start, struct timespec end);
+
+//* ------------------------------------------
+//* FUNCTION IMPLEMENTATIONS
+
+int main(void) {
+    const int sizes[] = { 512, 8192, 65536 };
+
+    OpenCacheCounters();
+
+    printf("%8s %8s %10s %14s %22s   (per enemy per frame)\n", "enemies", "order", "ns", counterNames[0], counterNames[1]);
+    for(int i = 0; i < (int) (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int numOfEnemies = sizes[i];
+
+        SpawnEnemies(numOfEnemies);
+        PrintResult(numOfEnemies, "spawn", RunNeighbourQueries());
+
+        ShuffleEnemies();
+        PrintResult(numOfEnemies, "random", RunNeighbourQueries());
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bool isSorted = SortEnemies();
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        PrintResult(numOfEnemies, "morton", RunNeighbourQueries());
+        printf("%8s SortEnemies %s in %.2f ms\n", "", isSorted ? "sorted the pool" : "left the pool as is",
+               GetElapsedNanoseconds(start, end) / 1e6);
+
+        UnloadEnemyPool();
+    }
+
+    printf("checksum %ld\n", checksum);
+    return 0;
+}
+
+static int RandomInt(int min, int max) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return min + (int) ((randomState >> 8) % (unsigned int) (max - min + 1));
+}
+
+static void SpawnEnemies(int numOfEnemies) {
+    // One extra slot, the permutations use it as temporary storage.
+    enemies = (EnemyPool){ 0 };
+    ResizeEnemyPool(numOfEnemies + 1);
+    ClearEnemyHash();
+
+    int roomsPerSide = BENCH_MAP_SIZE / BENCH_ROOM_SIZE;
+    int roomX = 0, roomY = 0;
+    EnemyType type = 0;
+
+    for(int i = 0; i < numOfEnemies; i++) {
+        // Rooms are visited at random, each one filled before the next, like SpawnRegionEnemies.
+        if(i % BENCH_ROOM_ENEMIES == 0) {
+            roomX = RandomInt(0, roomsPerSide - 1);
+            roomY = RandomInt(0, roomsPerSide - 1);
+            type  = (EnemyType) RandomInt(0, MAX_ENEMY_TYPES - 1);
+        }
+
+        // Added at the end of its partition, the following partitions move one slot forward.
+        int slot = enemies.typeStarts[type + 1];
+        for(int next = MAX_ENEMY_TYPES - 1; next > type; next--) {
+            int first = enemies.typeStarts[next];
+            int last  = enemies.typeStarts[next + 1];
+            if(first != last) CopyEnemySlot(first, last);
+            enemies.typeStarts[next + 1]++;
+        }
+        enemies.typeStarts[type + 1]++;
+        enemies.size++;
+
+        Vector2 pos = { (roomX * BENCH_ROOM_SIZE + RandomInt(0, BENCH_ROOM_SIZE - 1)) * TILE_WIDTH,
+                        (roomY * BENCH_ROOM_SIZE + RandomInt(0, BENCH_ROOM_SIZE - 1)) * TILE_HEIGHT };
+
+        enemies.entities[slot]        = (Entity){ 0 };
+        enemies.entities[slot].pos    = pos;
+        enemies.entities[slot].hitbox = (Rectangle){ pos.x, pos.y + 8, 16, 8 };
+        enemies.entities[slot].health = 1;
+        enemies.positions[slot]       = pos;
+        enemies.hitboxes[slot]        = enemies.entities[slot].hitbox;
+        enemies.types[slot]           = type;
+
+        enemies.ids[slot]                  = enemies.freeIds[--enemies.numOfFreeIds];
+        enemies.idSlots[enemies.ids[slot]] = slot;
+    }
+
+    // Inserted backwards, so each bucket lists its enemies in increasing slots.
+    for(int slot = enemies.size - 1; slot >= 0; slot--) InsertEnemyInHash(slot);
+}
+
+static void ShuffleEnemies() {
+    for(int type = 0; type < MAX_ENEMY_TYPES; type++) {
+        int first = enemies.typeStarts[type];
+        int last  = enemies.typeStarts[type + 1];
+
+        for(int slot = first; slot < last; slot++) enemies.sortSlots[slot] = slot;
+        for(int slot = last - 1; slot > first; slot--) {
+            int other                = RandomInt(first, slot);
+            int temp                 = enemies.sortSlots[slot];
+            enemies.sortSlots[slot]  = enemies.sortSlots[other];
+            enemies.sortSlots[other] = temp;
+        }
+        PermuteEnemies(first, last);
+    }
+
+    ClearEnemyHash();
+    for(int slot = enemies.size - 1; slot >= 0; slot--) InsertEnemyInHash(slot);
+}
+
+static BenchResult RunNeighbourQueries() {
+    int nearSlots[MAX_ENEMY_NEIGHBOURS + 1];
+    struct timespec start, end;
+
+    EnableCacheCounters(true);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(int frame = 0; frame < BENCH_NUM_OF_FRAMES; frame++) {
+        // The neighbours are read from a copy of the entities, like the parallel update does.
+        memcpy(enemies.snapshot, enemies.entities, enemies.size * sizeof(Entity));
+
+        for(int slot = 0; slot < enemies.size; slot++) {
+            Rectangle hitbox     = enemies.hitboxes[slot];
+            Rectangle searchArea = { hitbox.x - TILE_WIDTH, hitbox.y - TILE_HEIGHT,
+                                     hitbox.width + 2 * TILE_WIDTH, hitbox.height + 2 * TILE_HEIGHT };
+
+            int numOfNearSlots = QueryEnemiesInRect(searchArea, nearSlots, MAX_ENEMY_NEIGHBOURS + 1);
+            if(numOfNearSlots > MAX_ENEMY_NEIGHBOURS + 1) numOfNearSlots = MAX_ENEMY_NEIGHBOURS + 1;
+
+            checksum += enemies.entities[slot].health;
+            for(int i = 0; i < numOfNearSlots; i++) {
+                if(nearSlots[i] != slot) checksum += (long) enemies.snapshot[nearSlots[i]].pos.x;
+            }
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    EnableCacheCounters(false);
+
+    double numOfSteps  = (double) BENCH_NUM_OF_FRAMES * enemies.size;
+    BenchResult result = { GetElapsedNanoseconds(start, end) / numOfSteps, { -1, -1 } };
+    for(int i = 0; i < BENCH_NUM_OF_COUNTERS; i++) {
+        long misses = ReadCacheCounter(i);
+        if(misses >= 0) result.misses[i] = misses / numOfSteps;
+    }
+    return result;
+}
+
+static void OpenCacheCounters() {
+#if defined(__linux__)
+    const unsigned int types[BENCH_NUM_OF_COUNTERS]        = { PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE };
+    const unsigned long long configs[BENCH_NUM_OF_COUNTERS] = {
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+
+    for(int i = 0; i < BENCH_NUM_OF_COUNTERS; i++) {
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size           = sizeof(attr);
+        attr.type           = types[i];
+        attr.config         = configs[i];
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        counters[i] = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    }
+#endif
+
+    for(int i = 0; i < BENCH_NUM_OF_COUNTERS; i++) {
+        if(counters[i] == -1) printf("enemy-sort-bench: %s counter not available.\n", counterNames[i]);
+    }
+}
+
+static void EnableCacheCounters(bool isEnabled) {
+#if defined(__linux__)
+    for(int i = 0; i < BENCH_NUM_OF_COUNTERS; i++) {
+        if(counters[i] == -1) continue;
+
+        if(isEnabled) {
+            ioctl(counters[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters[i], PERF_EVENT_IOC_ENABLE, 0);
+        } else {
+            ioctl(counters[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+#else
+    (void) isEnabled;
+#endif
+}
+
+static long ReadCacheCounter(int counter) {
+#if defined(__linux__)
+    long long value;
+    if(counters[counter] != -1 && read(counters[counter], &value, sizeof(value)) == sizeof(value)) return (long) value;
+#else
+    (void) counter;
+#endif
+    return -1;
+}
+
+static void PrintResult(int numOfEnemies, const char* order, BenchResult result) {
+    printf("%8d %8s %10.1f", numOfEnemies, order, result.time);
+    for(int i = 0; i < BENCH_NUM_OF_COUNTERS; i++) {
+        int width = i == 0 ? 14 : 22;
+        if(result.misses[i] >= 0) {
+            printf(" %*.2f", width, result.misses[i]);
+        } else {
+            printf(" %*s", width, "n/a");
+        }
+    }
+    printf("\n");
+}
+
+static double GetElapsedNanoseconds(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}